@@ -0,0 +1,599 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Benchmark driver. A synthetic circuit (see synth.h) is generated from the command line parameters and the main steps
+ of the program are timed on it: fileRead (parsing and setting up the deductive simulator), the circuit image,
+ bit-parallel good machine simulation (simVectors and the SIMD kernels), deductive fault simulation (applyInput, as
+ simCircuit runs it), PPSFP fault simulation (64 bit, SIMD-wide and the parallel driver on --threads threads), the
+ report output (flushed per line and buffered) and the binary pattern file, and PODEM on the collapsed fault list with
+ one and with all threads, without the X-path check, with the default options, with static learning (whose own time
+ is reported once) and with fault dropping, followed by the SAT engine on the faults it aborts.
+ Every measurement is the best of --repeat runs. The results are printed as one JSON object (or written to --out) so
+ runs of different commits can be compared by a script; "make benchmark" runs it with a fixed parameter set (see the
+ Makefile). Built from the same sources as the program, with main.cpp compiled with -DPODEM_NO_MAIN so bench.cpp
+ provides main ("make bench").
+
+ Options: --inputs N --gates N --depth N --fanin N --reconvergence P --redundant N --seed N (the circuit),
+          --vectors N,N,.. (vector counts of the simulation runs), --threads N, --backtracks N (1000 by default),
+          --simd BITS, --repeat N, --out FILE and --keep (keep the generated circuit file).
+ With --check nothing is timed: the simulators, the circuit image, the pattern file and the test generators are
+ compared with each other on the circuit (with the last --vectors count) and the exit status is 1 if any of them
+ disagree ("make check").
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "Classes.h"
+#include "circuit.h"
+#include "cktimage.h"
+#include "deductive.h"
+#include "faults.h"
+#include "faultsim.h"
+#include "fpsim.h"
+#include "learn.h"
+#include "output.h"
+#include "patfile.h"
+#include "podem.h"
+#include "ppsfp.h"
+#include "psim.h"
+#include "randpat.h"
+#include "satatpg.h"
+#include "simd.h"
+#include "synth.h"
+
+using namespace std;
+
+// Program state and functions from main.cpp.
+extern bool simFlag;
+extern bool imageFlag;
+extern deductiveSim dSim;
+void fileRead (const string& file);
+const vector<unsigned> &applyInput (vector<vector<bool>> &cktIn, int n);
+
+static double now() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs f repeat times and returns the shortest time in seconds.
+template <typename F>
+static double bestOf (unsigned repeat, F f) {
+    double best = 1e300;
+    for (unsigned r = 0; r < repeat; r++) {
+        double t0 = now();
+        f();
+        double t = now() - t0;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+static vector<vector<bool>> seededVectors (unsigned n, unsigned numIn, uint64_t seed) {
+    patternRng rng(seed);
+    vector<vector<bool>> vecs;
+    vector<uint64_t> piWords;
+    for (unsigned first = 0; first < n; first += BLOCK_SIZE) {
+        rng.fill(piWords, numIn);
+        unpackVectors(piWords, min<unsigned>(BLOCK_SIZE, n - first), vecs);
+    }
+    return vecs;
+}
+
+// The deductive simulation of simCircuit without the printing: every vector with all faults.
+static unsigned deductiveRun (vector<vector<bool>> &vecs) {
+    unsigned detected = 0;
+    for (unsigned i = 0; i < vecs.size(); i++) detected += applyInput(vecs, i).size();
+    return detected;
+}
+
+// Number of the DETECTED results whose test (X inputs as 0) does not detect its fault in the PPSFP simulator.
+static unsigned falseTests (const vector<pair<unsigned int, bool>> &faults, const vector<podemResult> &results) {
+    ppsfp sim(ckt);
+    vector<testCube> test(1);
+    vector<uint64_t> piWords;
+    unsigned bad = 0;
+    for (unsigned f = 0; f < faults.size(); f++) {
+        if (results[f].status != DETECTED) continue;
+        test[0] = results[f].test;
+        packCubes(test, 0, 1, piWords);
+        sim.goodSim(piWords);
+        bad += !sim.detect(faults[f].first, faults[f].second, 1);
+    }
+    return bad;
+}
+
+// --check: instead of timing them, the simulators, the circuit image, the pattern file and the test generators are
+// run on the loaded circuit and compared with each other. Every check prints one line, the function returns the
+// number of checks that failed.
+static unsigned runChecks (const string &cktFile, unsigned n, unsigned threads, const podemOptions &options,
+                           const vector<pair<unsigned int, bool>> &redundantFaults, uint64_t seed) {
+    unsigned failed = 0;
+    auto report = [&](const string &name, unsigned long long bad) {
+        cout << (bad ? "FAILED " : "ok     ") << name;
+        if (bad) cout << " (" << bad << " mismatches)";
+        cout << endl;
+        failed += (bad != 0);
+    };
+
+    // Good machine outputs: the bit-parallel simulation is the reference.
+    vector<vector<bool>> vecs = seededVectors(n, ckt.PIs.size(), seed);
+    compiledCircuit tape(ckt);
+    vector<vector<bool>> outRef = simVectors(ckt, vecs), outWide = simVectorsWide(tape, vecs);
+    unsigned long long bad = 0;
+    for (unsigned i = 0; i < n; i++) bad += (outWide[i] != outRef[i]);
+    report("simVectorsWide outputs", bad);
+
+    vector<vector<unsigned>> deductive(n);
+    bad = 0;
+    for (unsigned i = 0; i < n; i++) {
+        deductive[i] = applyInput(vecs, i);
+        for (unsigned o = 0; o < ckt.POs.size(); o++) bad += (dSim.values()[ckt.POs[o]] != outRef[i][o]);
+    }
+    report("deductive outputs", bad);
+
+    // Every detection of every fault of the universe, as one bit per (fault, vector): the 64 bit PPSFP simulator is
+    // the reference.
+    faultSet fSet;
+    fSet.build(ckt);
+    const vector<pair<unsigned int, bool>> &faults = fSet.universe;
+    unsigned words = parallelFaultSim::wordsPer(n);
+    auto differences = [&](const vector<uint64_t> &a, const vector<uint64_t> &b) {
+        unsigned long long d = 0;
+        for (unsigned i = 0; i < a.size(); i++) d += __builtin_popcountll(a[i] ^ b[i]);
+        return d;
+    };
+
+    vector<uint64_t> ref(faults.size() * words, 0), piWords;
+    ppsfp fSim(ckt);
+    for (unsigned first = 0; first < n; first += BLOCK_SIZE) {
+        unsigned count = min<unsigned>(BLOCK_SIZE, n - first);
+        uint64_t mask = (count == BLOCK_SIZE) ? ~0ULL : (1ULL << count) - 1;
+        packVectors(vecs, first, count, piWords);
+        fSim.goodSim(piWords);
+        for (unsigned f = 0; f < faults.size(); f++) {
+            ref[f * words + first / 64] = fSim.detect(faults[f].first, faults[f].second, mask);
+        }
+    }
+
+    vector<uint64_t> det(faults.size() * words, 0);
+    wideFaultSim wSim(ckt, tape);
+    unsigned width = wSim.bits(), wWords = wSim.words();
+    vector<uint64_t> mask(wWords), wDet(wWords);
+    for (unsigned first = 0; first < n; first += width) {
+        unsigned count = min(width, n - first);
+        mask.assign(wWords, 0);
+        for (unsigned k = 0; k < count; k++) mask[k / 64] |= 1ULL << (k % 64);
+        packWide(vecs, first, count, wWords, piWords);
+        wSim.goodSim(piWords);
+        for (unsigned f = 0; f < faults.size(); f++) {
+            wSim.detect(faults[f].first, faults[f].second, mask.data(), wDet.data());
+            for (unsigned k = 0; k < wWords && first / 64 + k < words; k++) det[f * words + first / 64 + k] = wDet[k];
+        }
+    }
+    report("widePpsfp detections", differences(det, ref));
+
+    parallelFaultSim pSim(ckt, tape, threads);
+    pSim.detectAll(faults, vecs, 0, n, det);
+    report("parallelPpsfp detections", differences(det, ref));
+
+    vector<int> firstDet = pSim.firstDetection(faults, vecs);
+    bad = 0;
+    for (unsigned f = 0; f < faults.size(); f++) {
+        int expected = -1;
+        for (unsigned w = 0; w < words && expected < 0; w++) {
+            if (ref[f * words + w]) expected = 64 * w + __builtin_ctzll(ref[f * words + w]);
+        }
+        bad += (firstDet[f] != expected);
+    }
+    report("parallelPpsfp first detections", bad);
+
+    det.assign(faults.size() * words, 0);
+    faultParallelSim fpSim(ckt);
+    vector<unsigned> all(faults.size()), detected;
+    for (unsigned f = 0; f < faults.size(); f++) all[f] = f;
+    for (unsigned i = 0; i < n; i++) {
+        fpSim.goodSim(testCube::fromVector(vecs[i]));
+        detected.clear();
+        fpSim.detect(faults, all, detected);
+        for (auto f: detected) det[f * words + i / 64] |= 1ULL << (i % 64);
+    }
+    report("fault-parallel detections", differences(det, ref));
+
+    det.assign(faults.size() * words, 0);
+    for (unsigned i = 0; i < n; i++) {
+        for (auto f: deductive[i]) det[f * words + i / 64] |= 1ULL << (i % 64);
+    }
+    report("deductive detections", differences(det, ref));
+
+    // The circuit image has to give back the parsed circuit.
+    circuit imaged;
+    loadCircuit(cktFile, imaged, true); // Writes the image.
+    bool loaded = loadCircuit(cktFile, imaged, true);
+    bad = !loaded + (imaged.type != ckt.type) + (imaged.outWire != ckt.outWire) +
+          (imaged.faninStart != ckt.faninStart) + (imaged.faninWire != ckt.faninWire) + (imaged.level != ckt.level) +
+          (imaged.order != ckt.order) + (imaged.levelStart != ckt.levelStart) + (imaged.driver != ckt.driver) +
+          (imaged.fanoutStart != ckt.fanoutStart) + (imaged.fanoutGate != ckt.fanoutGate) +
+          (imaged.piIndex != ckt.piIndex) + (imaged.poWire != ckt.poWire) + (imaged.PIs != ckt.PIs) +
+          (imaged.POs != ckt.POs) + (imaged.CC0 != ckt.CC0) + (imaged.CC1 != ckt.CC1) + (imaged.CO != ckt.CO) +
+          (imaged.maxLevel != ckt.maxLevel);
+    report("circuit image", bad);
+
+    // The pattern file has to give back what was written, X inputs included.
+    patternSet pSet, readBack;
+    pSet.PIs = ckt.PIs;
+    pSet.POs = ckt.POs;
+    for (unsigned i = 0; i < n; i++) {
+        testCube t(ckt.PIs.size());
+        for (unsigned j = 0; j < ckt.PIs.size(); j++) {
+            if (vecs[i][j]) t.set(j, vecs[(i + 1) % n][j]);
+        }
+        pSet.patterns.push_back(t);
+    }
+    pSet.faults = faults;
+    for (unsigned f = 0; f < faults.size(); f++) {
+        pSet.status.push_back(static_cast<eFaultStatus>(f % 3));
+        pSet.detectedBy.push_back((f % 3 == DETECTED) ? (int) (f % n) : -1);
+    }
+    string patPath = cktFile + ".pat", error;
+    bool ok = writePatternFile(patPath, pSet) && readPatternFile(patPath, readBack, error);
+    remove(patPath.c_str());
+    bad = !ok + (readBack.PIs != pSet.PIs) + (readBack.POs != pSet.POs) + (readBack.patterns != pSet.patterns) +
+          (readBack.faults != pSet.faults) + (readBack.status != pSet.status) +
+          (readBack.detectedBy != pSet.detectedBy);
+    report("pattern file", bad);
+
+    // Test generation: every test has to detect its fault, the results may not depend on the thread count, and no
+    // engine may call a fault redundant that another one detects.
+    vector<pair<unsigned int, bool>> targets;
+    for (auto t: fSet.targets) targets.push_back(fSet.universe[t]);
+    targets.insert(targets.end(), redundantFaults.begin(), redundantFaults.end());
+    vector<podemResult> one = runPODEM(ckt, targets, 1, options), many = runPODEM(ckt, targets, threads, options);
+    report("PODEM tests", falseTests(targets, one));
+    bad = 0;
+    for (unsigned f = 0; f < targets.size(); f++) {
+        bad += (one[f].status != many[f].status) || (one[f].backtracks != many[f].backtracks) ||
+               !(one[f].test == many[f].test);
+    }
+    report("PODEM on " + to_string(threads) + " threads", bad);
+
+    bad = 0;
+    for (unsigned f = targets.size() - redundantFaults.size(); f < targets.size(); f++) {
+        bad += (one[f].status == DETECTED);
+    }
+    report("PODEM on the redundant faults", bad);
+
+    vector<int> source;
+    vector<podemResult> dropping = runPODEMDropping(ckt, targets, threads, options, nullptr, source);
+    report("PODEM with dropping tests", falseTests(targets, dropping));
+    bad = 0;
+    for (unsigned f = 0; f < targets.size(); f++) {
+        bad += (dropping[f].status == DETECTED && one[f].status == REDUNDANT) ||
+               (dropping[f].status == REDUNDANT && one[f].status == DETECTED) ||
+               ((source[f] >= 0) != (dropping[f].status == DETECTED));
+    }
+    report("PODEM with dropping status", bad);
+
+    vector<podemResult> sat = one;
+    satFallback(ckt, targets, sat, threads, satOptions());
+    report("SAT tests", falseTests(targets, sat));
+    bad = 0;
+    for (unsigned f = 0; f < targets.size(); f++) {
+        bad += (sat[f].status == REDUNDANT && one[f].status == DETECTED) ||
+               (sat[f].status == DETECTED && one[f].status == REDUNDANT);
+    }
+    report("SAT status", bad);
+    return failed;
+}
+
+int main (int argc, char* argv[]) {
+    synthParams p;
+    vector<unsigned> vectorCounts = {64, 1024, 8192};
+    unsigned threads = thread::hardware_concurrency(), repeat = 3;
+    podemOptions options;
+    options.backtracks = 1000;
+    string outFile, cktFile = "bench_circuit.txt";
+    bool keep = false, check = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--inputs" && hasValue) p.inputs = stoul(argv[++i]);
+        else if (arg == "--gates" && hasValue) p.gates = stoul(argv[++i]);
+        else if (arg == "--depth" && hasValue) p.depth = stoul(argv[++i]);
+        else if (arg == "--fanin" && hasValue) p.fanin = stoul(argv[++i]);
+        else if (arg == "--reconvergence" && hasValue) p.reconvergence = stod(argv[++i]);
+        else if (arg == "--redundant" && hasValue) p.redundant = stoul(argv[++i]);
+        else if (arg == "--seed" && hasValue) p.seed = stoull(argv[++i]);
+        else if (arg == "--threads" && hasValue) threads = stoul(argv[++i]);
+        else if (arg == "--backtracks" && hasValue) options.backtracks = stoul(argv[++i]);
+        else if (arg == "--repeat" && hasValue) repeat = max(1ul, stoul(argv[++i]));
+        else if (arg == "--out" && hasValue) outFile = argv[++i];
+        else if (arg == "--keep") keep = true;
+        else if (arg == "--check") check = true;
+        else if (arg == "--simd" && hasValue) setSimdWidth(stoul(argv[++i]));
+        else if (arg == "--vectors" && hasValue) {
+            vectorCounts.clear();
+            stringstream list(argv[++i]);
+            string n;
+            while (getline(list, n, ',')) vectorCounts.push_back(stoul(n));
+        }
+        else {
+            cout << "Unknown option " << arg << endl;
+            return 1;
+        }
+    }
+    if (threads == 0) threads = 1;
+
+    vector<pair<unsigned int, bool>> redundantFaults;
+    if (!writeSynthetic(cktFile, p, redundantFaults)) {
+        cout << "The synthetic circuit could not be generated (check the gate count against the depth)." << endl;
+        return 1;
+    }
+
+    if (check) {
+        simFlag = true;
+        imageFlag = false;
+        fileRead(cktFile);
+        unsigned failed = runChecks(cktFile, vectorCounts.back(), threads, options, redundantFaults, p.seed);
+        if (!keep) {
+            remove(cktFile.c_str());
+            remove((cktFile + ".cimg").c_str());
+        }
+        cout << (failed ? to_string(failed) + " CHECKS FAILED." : "ALL CHECKS PASSED.") << endl;
+        return failed ? 1 : 0;
+    }
+
+    ostringstream js;
+    js.precision(6);
+
+    // fileRead with all the faults of the deductive simulator enabled, parsing the text every time.
+    simFlag = true;
+    imageFlag = false;
+    double tRead = bestOf(repeat, [&]() {
+        fileRead(cktFile);
+    });
+    unsigned nG = ckt.numGates();
+
+    js << "{\n  \"circuit\": {\"inputs\": " << ckt.PIs.size() << ", \"outputs\": " << ckt.POs.size() << ", \"gates\": " << nG;
+    js << ", \"levels\": " << ckt.maxLevel << ", \"fanin\": " << p.fanin << ", \"reconvergence\": " << p.reconvergence;
+    js << ", \"seed\": " << p.seed << "},\n";
+    js << "  \"fileRead\": {\"seconds\": " << tRead << ", \"gatesPerSec\": " << nG / tRead << "},\n";
+
+    // Circuit image: the first load writes it, the timed loads read it.
+    circuit imaged;
+    loadCircuit(cktFile, imaged, true);
+    double tImage = bestOf(repeat, [&]() { loadCircuit(cktFile, imaged, true); });
+    js << "  \"imageLoad\": {\"seconds\": " << tImage << ", \"gatesPerSec\": " << nG / tImage << "},\n";
+
+    compiledCircuit tape(ckt);
+    js << "  \"simulation\": [";
+    for (unsigned v = 0; v < vectorCounts.size(); v++) {
+        unsigned n = vectorCounts[v];
+        vector<vector<bool>> vecs = seededVectors(n, ckt.PIs.size(), p.seed + v);
+        double tGood = bestOf(repeat, [&]() { simVectors(ckt, vecs); });
+        js << (v ? ",\n" : "\n") << "    {\"vectors\": " << n << ", \"simVectors\": {\"seconds\": " << tGood;
+        js << ", \"gateEvalsPerSec\": " << (double) nG * n / tGood << "}";
+        double tWide = bestOf(repeat, [&]() { simVectorsWide(tape, vecs); });
+        js << ", \"simVectorsWide\": {\"bits\": " << simdWidth() << ", \"seconds\": " << tWide;
+        js << ", \"gateEvalsPerSec\": " << (double) nG * n / tWide << "}";
+
+        unsigned detected = 0;
+        double tDed = bestOf(repeat, [&]() { detected = deductiveRun(vecs); });
+        js << ", \"deductive\": {\"seconds\": " << tDed << ", \"gateEvalsPerSec\": " << (double) nG * n / tDed;
+        js << ", \"vectorsPerSec\": " << n / tDed << ", \"arenaBytes\": " << dSim.arenaSize() * sizeof(uint32_t);
+        js << ", \"detections\": " << detected << "}";
+
+        // PPSFP on the collapsed targets, without fault dropping, so the work is the same for every vector count.
+        faultSet fSet;
+        fSet.build(ckt);
+        ppsfp fSim(ckt);
+        vector<uint64_t> piWords;
+        unsigned long long detections = 0;
+        double tPpsfp = bestOf(repeat, [&]() {
+            detections = 0;
+            for (unsigned first = 0; first < n; first += BLOCK_SIZE) {
+                unsigned count = min<unsigned>(BLOCK_SIZE, n - first);
+                uint64_t mask = (count == BLOCK_SIZE) ? ~0ULL : (1ULL << count) - 1;
+                packVectors(vecs, first, count, piWords);
+                fSim.goodSim(piWords);
+                for (auto t: fSet.targets) {
+                    detections += __builtin_popcountll(fSim.detect(fSet.universe[t].first, fSet.universe[t].second, mask));
+                }
+            }
+        });
+        js << ", \"ppsfp\": {\"seconds\": " << tPpsfp << ", \"faults\": " << fSet.targets.size();
+        js << ", \"faultVectorsPerSec\": " << (double) fSet.targets.size() * n / tPpsfp << ", \"detections\": " << detections << "}";
+
+        // The same with the SIMD-wide kernels.
+        wideFaultSim wSim(ckt, tape);
+        unsigned width = wSim.bits(), words = wSim.words();
+        vector<uint64_t> mask(words), det(words);
+        double tWidePpsfp = bestOf(repeat, [&]() {
+            detections = 0;
+            for (unsigned first = 0; first < n; first += width) {
+                unsigned count = min(width, n - first);
+                mask.assign(words, 0);
+                for (unsigned k = 0; k < count; k++) mask[k / 64] |= 1ULL << (k % 64);
+                packWide(vecs, first, count, words, piWords);
+                wSim.goodSim(piWords);
+                for (auto t: fSet.targets) {
+                    wSim.detect(fSet.universe[t].first, fSet.universe[t].second, mask.data(), det.data());
+                    for (auto d: det) detections += __builtin_popcountll(d);
+                }
+            }
+        });
+        js << ", \"widePpsfp\": {\"bits\": " << width << ", \"seconds\": " << tWidePpsfp;
+        js << ", \"faultVectorsPerSec\": " << (double) fSet.targets.size() * n / tWidePpsfp << ", \"detections\": " << detections << "}";
+
+        // The parallel driver on all the threads, every detection and with fault dropping.
+        vector<pair<unsigned int, bool>> targets;
+        for (auto t: fSet.targets) targets.push_back(fSet.universe[t]);
+        parallelFaultSim pSim(ckt, tape, threads);
+        vector<uint64_t> detAll;
+        double tAll = bestOf(repeat, [&]() { pSim.detectAll(targets, vecs, 0, n, detAll); });
+        unsigned dropped = 0;
+        double tFirst = bestOf(repeat, [&]() {
+            vector<int> first = pSim.firstDetection(targets, vecs);
+            dropped = 0;
+            for (auto v: first) dropped += (v >= 0);
+        });
+        js << ", \"parallelPpsfp\": {\"threads\": " << threads << ", \"seconds\": " << tAll;
+        js << ", \"faultVectorsPerSec\": " << (double) targets.size() * n / tAll << ", \"droppingSeconds\": " << tFirst;
+        js << ", \"detected\": " << dropped << "}}";
+    }
+    js << "\n  ],\n";
+
+    // Report output: the fault lines of simCircuit for 1M detections, through an fstream with endl (one flush per
+    // line, as the report used to be written) and through the buffered stream, with and without the writer thread.
+    {
+        faultSet fSet;
+        fSet.build(ckt);
+        const unsigned lines = 1000000;
+        string outPath = cktFile + ".out";
+        auto report = [&](ostream &out) {
+            for (unsigned i = 0; i < lines; i++) {
+                auto &f = fSet.universe[i % fSet.universe.size()];
+                out << f.first << " stuck at " << f.second << endl;
+            }
+        };
+        double tFlush = bestOf(repeat, [&]() {
+            fstream out(outPath, ios::out);
+            report(out);
+        });
+        double tBuffered = bestOf(repeat, [&]() {
+            reportStream out;
+            out.open(outPath);
+            report(out);
+            out.close();
+        });
+        double tBackground = bestOf(repeat, [&]() {
+            reportStream out;
+            out.open(outPath, true);
+            report(out);
+            out.close();
+        });
+
+        // The binary pattern file of the largest vector set, with every fault of the universe.
+        patternSet pSet;
+        pSet.PIs = ckt.PIs;
+        pSet.POs = ckt.POs;
+        for (auto &v: seededVectors(vectorCounts.back(), ckt.PIs.size(), p.seed)) {
+            pSet.patterns.push_back(testCube::fromVector(v));
+        }
+        pSet.faults = fSet.universe;
+        pSet.status.assign(pSet.faults.size(), DETECTED);
+        pSet.detectedBy.assign(pSet.faults.size(), 0);
+        double tPatterns = bestOf(repeat, [&]() { writePatternFile(outPath, pSet, true); });
+        remove(outPath.c_str());
+        js << "  \"output\": {\"lines\": " << lines << ", \"flushPerLineSeconds\": " << tFlush;
+        js << ", \"bufferedSeconds\": " << tBuffered << ", \"backgroundSeconds\": " << tBackground;
+        js << ", \"patternFile\": {\"patterns\": " << pSet.patterns.size() << ", \"seconds\": " << tPatterns << "}},\n";
+    }
+
+    // PODEM on the collapsed fault list, plus the faults that are redundant by construction.
+    faultSet fSet;
+    fSet.build(ckt);
+    vector<pair<unsigned int, bool>> faults;
+    for (auto t: fSet.targets) faults.push_back(fSet.universe[t]);
+    unsigned firstRedundant = faults.size();
+    faults.insert(faults.end(), redundantFaults.begin(), redundantFaults.end());
+
+    staticLearning learned;
+    double tLearn = bestOf(repeat, [&]() { learned.build(ckt); });
+    js << "  \"learning\": {\"seconds\": " << tLearn << ", \"implications\": " << learned.implications();
+    js << ", \"constants\": " << learned.constants() << "},\n";
+
+    js << "  \"podem\": [";
+    vector<unsigned> threadCounts = {1};
+    if (threads > 1) threadCounts.push_back(threads);
+    for (unsigned k = 0; k < threadCounts.size(); k++) {
+        vector<podemResult> results;
+        double tPodem = bestOf(repeat, [&]() { results = runPODEM(ckt, faults, threadCounts[k], options); });
+        unsigned count[3] = {0, 0, 0}, proven = 0;
+        unsigned long long backtracks = 0;
+        for (unsigned f = 0; f < results.size(); f++) {
+            count[results[f].status]++;
+            backtracks += results[f].backtracks;
+            if (f >= firstRedundant && results[f].status == REDUNDANT) proven++;
+        }
+        js << (k ? ",\n" : "\n") << "    {\"threads\": " << threadCounts[k] << ", \"faults\": " << faults.size();
+        js << ", \"seconds\": " << tPodem << ", \"faultsPerSec\": " << faults.size() / tPodem;
+        js << ", \"detected\": " << count[DETECTED] << ", \"redundant\": " << count[REDUNDANT] << ", \"aborted\": " << count[ABORTED];
+        js << ", \"backtracks\": " << backtracks << ", \"knownRedundant\": " << redundantFaults.size();
+        js << ", \"knownRedundantProven\": " << proven;
+
+        // The same faults without the X-path check, to show the decisions it saves.
+        podemOptions noXPath = options;
+        noXPath.xPath = false;
+        vector<podemResult> noXPathResults;
+        double tNoXPath = bestOf(repeat, [&]() { noXPathResults = runPODEM(ckt, faults, threadCounts[k], noXPath); });
+        unsigned noXPathAborted = 0;
+        unsigned long long noXPathBacktracks = 0;
+        for (auto &r: noXPathResults) {
+            noXPathAborted += (r.status == ABORTED);
+            noXPathBacktracks += r.backtracks;
+        }
+        js << ", \"withoutXPath\": {\"seconds\": " << tNoXPath << ", \"aborted\": " << noXPathAborted;
+        js << ", \"backtracks\": " << noXPathBacktracks << "}";
+
+        // The same faults with the mandatory assignments of the static learning.
+        vector<podemResult> learnResults;
+        double tLearnPodem = bestOf(repeat, [&]() {
+            learnResults = runPODEM(ckt, faults, threadCounts[k], options, &learned);
+        });
+        unsigned learnCount[3] = {0, 0, 0};
+        unsigned long long learnBacktracks = 0;
+        for (auto &r: learnResults) {
+            learnCount[r.status]++;
+            learnBacktracks += r.backtracks;
+        }
+        js << ", \"withLearning\": {\"seconds\": " << tLearnPodem << ", \"detected\": " << learnCount[DETECTED];
+        js << ", \"redundant\": " << learnCount[REDUNDANT] << ", \"aborted\": " << learnCount[ABORTED];
+        js << ", \"backtracks\": " << learnBacktracks << "}";
+
+        // The same faults with fault dropping: PODEM only runs on the faults no earlier test detected.
+        vector<podemResult> dropResults;
+        vector<int> source;
+        double tDrop = bestOf(repeat, [&]() {
+            dropResults = runPODEMDropping(ckt, faults, threadCounts[k], options, nullptr, source);
+        });
+        unsigned podemRuns = 0, dropped = 0;
+        for (unsigned f = 0; f < faults.size(); f++) {
+            if (source[f] >= 0 && (unsigned)source[f] != f) dropped++;
+            else podemRuns++;
+        }
+        js << ", \"withDropping\": {\"seconds\": " << tDrop << ", \"podemRuns\": " << podemRuns;
+        js << ", \"dropped\": " << dropped << "}";
+
+        // The SAT engine on the faults that PODEM aborted.
+        vector<podemResult> satResults;
+        unsigned decided = 0;
+        double tSat = bestOf(repeat, [&]() {
+            satResults = results;
+            decided = satFallback(ckt, faults, satResults, threadCounts[k], satOptions());
+        });
+        proven = 0;
+        for (unsigned f = firstRedundant; f < faults.size(); f++) proven += (satResults[f].status == REDUNDANT);
+        js << ", \"satFallback\": {\"seconds\": " << tSat << ", \"decided\": " << decided;
+        js << ", \"knownRedundantProven\": " << proven << "}}";
+    }
+    js << "\n  ]\n}\n";
+
+    if (outFile.empty()) cout << js.str();
+    else {
+        ofstream out(outFile);
+        out << js.str();
+    }
+
+    if (!keep) {
+        remove(cktFile.c_str());
+        remove((cktFile + ".cimg").c_str());
+    }
+    return 0;
+}
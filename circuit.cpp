@@ -0,0 +1,206 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Construction of the levelized circuit graph (see circuit.h). fileRead adds the gates, primary inputs and primary
+ outputs as it reads them, then calls levelize once to build the fanout tables and the topological order, and
+ computeScoap once to get the testability measures used by PODEM.
+*/
+
+#include "circuit.h"
+
+circuit ckt;
+
+void circuit::clear() {
+    type.clear();
+    outWire.clear();
+    faninStart.assign(1, 0);
+    faninWire.clear();
+    level.clear();
+    order.clear();
+    levelStart.clear();
+    driver.clear();
+    fanoutStart.clear();
+    fanoutGate.clear();
+    piIndex.clear();
+    poWire.clear();
+    PIs.clear();
+    POs.clear();
+    CC0.clear();
+    CC1.clear();
+    CO.clear();
+    maxLevel = 0;
+}
+
+void circuit::growWires(unsigned wireID) {
+    if (wireID >= driver.size()) {
+        driver.resize(wireID + 1, NO_GATE);
+        piIndex.resize(wireID + 1, -1);
+        poWire.resize(wireID + 1, false);
+    }
+}
+
+void circuit::addGate(eGate gType, const vector<unsigned> &wires) {
+    if (faninStart.empty()) faninStart.push_back(0);
+    unsigned g = outWire.size();
+    unsigned out = wires.back();
+
+    type.push_back(gType);
+    outWire.push_back(out);
+    for (unsigned i = 0; i + 1 < wires.size(); i++) {
+        faninWire.push_back(wires[i]);
+        growWires(wires[i]);
+    }
+    faninStart.push_back(faninWire.size());
+
+    growWires(out);
+    driver[out] = g;
+}
+
+void circuit::addInput(unsigned wireID) {
+    growWires(wireID);
+    if (piIndex[wireID] >= 0) return; // Listed twice.
+    piIndex[wireID] = PIs.size();
+    PIs.push_back(wireID);
+}
+
+void circuit::addOutput(unsigned wireID) {
+    growWires(wireID);
+    if (poWire[wireID]) return;
+    poWire[wireID] = true;
+    POs.push_back(wireID);
+}
+
+bool circuit::levelize() {
+    unsigned nGates = numGates();
+    unsigned nWires = numWires();
+
+    // Count the fanout of every wire (a gate that uses the same wire twice is only a fanout once), then fill the table.
+    fanoutStart.assign(nWires + 1, 0);
+    for (unsigned g = 0; g < nGates; g++) {
+        const unsigned* in = fanin(g);
+        for (unsigned i = 0; i < numFanin(g); i++) {
+            bool repeat = false;
+            for (unsigned j = 0; j < i; j++) repeat |= (in[j] == in[i]);
+            if (!repeat) fanoutStart[in[i] + 1]++;
+        }
+    }
+    for (unsigned w = 0; w < nWires; w++) fanoutStart[w+1] += fanoutStart[w];
+
+    fanoutGate.assign(fanoutStart[nWires], 0);
+    vector<unsigned> fill(fanoutStart.begin(), fanoutStart.end() - 1);
+    for (unsigned g = 0; g < nGates; g++) {
+        const unsigned* in = fanin(g);
+        for (unsigned i = 0; i < numFanin(g); i++) {
+            bool repeat = false;
+            for (unsigned j = 0; j < i; j++) repeat |= (in[j] == in[i]);
+            if (!repeat) fanoutGate[fill[in[i]]++] = g;
+        }
+    }
+
+    // Kahn's algorithm: a gate can be levelized once every gate that drives one of its inputs has been.
+    vector<unsigned> pending(nGates, 0);
+    vector<unsigned> queue;
+    queue.reserve(nGates);
+    level.assign(nGates, 1);
+    for (unsigned g = 0; g < nGates; g++) {
+        const unsigned* in = fanin(g);
+        for (unsigned i = 0; i < numFanin(g); i++) {
+            if (driver[in[i]] != NO_GATE) pending[g]++;
+        }
+        if (pending[g] == 0) queue.push_back(g);
+    }
+
+    for (unsigned head = 0; head < queue.size(); head++) {
+        unsigned g = queue[head];
+        unsigned w = outWire[g];
+        for (unsigned i = fanoutStart[w]; i < fanoutStart[w+1]; i++) {
+            unsigned f = fanoutGate[i];
+            if (level[f] < level[g] + 1) level[f] = level[g] + 1;
+
+            // pending counted every input of f, so decrement once for each input that is w.
+            const unsigned* in = fanin(f);
+            for (unsigned j = 0; j < numFanin(f); j++) {
+                if (in[j] == w && --pending[f] == 0) queue.push_back(f);
+            }
+        }
+    }
+
+    if (queue.size() != nGates) return false;
+
+    // Counting sort of the gates by level so that order[] is stable with respect to the file order.
+    maxLevel = 0;
+    for (unsigned g = 0; g < nGates; g++) if (level[g] > maxLevel) maxLevel = level[g];
+    levelStart.assign(maxLevel + 2, 0);
+    for (unsigned g = 0; g < nGates; g++) levelStart[level[g] + 1]++;
+    for (unsigned l = 0; l <= maxLevel; l++) levelStart[l+1] += levelStart[l];
+
+    order.assign(nGates, 0);
+    fill.assign(levelStart.begin(), levelStart.end() - 1);
+    for (unsigned g = 0; g < nGates; g++) order[fill[level[g]]++] = g;
+    return true;
+}
+
+static unsigned scoapAdd (unsigned a, unsigned b) { return (a + b > SCOAP_INF) ? SCOAP_INF : a + b; }
+
+/*
+ * SCOAP Pseudocode:
+ * Controllability goes forward in level order. A primary input costs 1 to set to either value. A gate output costs one
+ * more than the cheapest input at the controlling value (for the controlled output value) or the sum of all inputs at
+ * the non-controlling value (for the other output value); inverting gates swap the two.
+ * Observability goes backward in reverse level order. A primary output costs 0 to observe. An input of a gate costs
+ * the observability of the gate output plus the cost of setting every other input to the non-controlling value, plus
+ * one. A wire with several fanouts takes its cheapest branch.
+ */
+void circuit::computeScoap() {
+    unsigned nWires = numWires();
+    CC0.assign(nWires, SCOAP_INF);
+    CC1.assign(nWires, SCOAP_INF);
+    CO.assign(nWires, SCOAP_INF);
+    for (auto w: PIs) CC0[w] = CC1[w] = 1;
+
+    for (unsigned g: order) {
+        const unsigned* in = fanin(g);
+        unsigned n = numFanin(g);
+        unsigned o = outWire[g];
+        unsigned minC0 = SCOAP_INF, minC1 = SCOAP_INF, sumC0 = 0, sumC1 = 0;
+        for (unsigned i = 0; i < n; i++) {
+            if (CC0[in[i]] < minC0) minC0 = CC0[in[i]];
+            if (CC1[in[i]] < minC1) minC1 = CC1[in[i]];
+            sumC0 = scoapAdd(sumC0, CC0[in[i]]);
+            sumC1 = scoapAdd(sumC1, CC1[in[i]]);
+        }
+
+        switch (type[g]) {
+            case AND:  CC0[o] = scoapAdd(minC0, 1); CC1[o] = scoapAdd(sumC1, 1); break;
+            case NAND: CC0[o] = scoapAdd(sumC1, 1); CC1[o] = scoapAdd(minC0, 1); break;
+            case OR:   CC0[o] = scoapAdd(sumC0, 1); CC1[o] = scoapAdd(minC1, 1); break;
+            case NOR:  CC0[o] = scoapAdd(minC1, 1); CC1[o] = scoapAdd(sumC0, 1); break;
+            case INV:  CC0[o] = scoapAdd(CC1[in[0]], 1); CC1[o] = scoapAdd(CC0[in[0]], 1); break;
+            default:   CC0[o] = scoapAdd(CC0[in[0]], 1); CC1[o] = scoapAdd(CC1[in[0]], 1); break; // BUF
+        }
+    }
+
+    for (auto w: POs) CO[w] = 0;
+    for (unsigned k = order.size(); k-- > 0;) {
+        unsigned g = order[k];
+        const unsigned* in = fanin(g);
+        unsigned n = numFanin(g);
+        unsigned o = outWire[g];
+        if (CO[o] >= SCOAP_INF) continue; // Nothing behind an unobservable output is observable through it.
+
+        bool andType = (type[g] == AND) || (type[g] == NAND);
+        bool orType = (type[g] == OR) || (type[g] == NOR);
+        for (unsigned i = 0; i < n; i++) {
+            unsigned cost = scoapAdd(CO[o], 1);
+            for (unsigned j = 0; j < n; j++) {
+                if (j == i) continue;
+                if (andType) cost = scoapAdd(cost, CC1[in[j]]);
+                else if (orType) cost = scoapAdd(cost, CC0[in[j]]);
+            }
+            if (cost < CO[in[i]]) CO[in[i]] = cost;
+        }
+    }
+}
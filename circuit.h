@@ -0,0 +1,74 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Compact, levelized and index-based view of the circuit that is built by fileRead. Gates are stored in contiguous
+ arrays (in the same order as they appear in the circuit file, so gate index g corresponds to the g-th gate that was
+ created) and every wire ID can be resolved to its driving gate and its fanout gates through index tables. This lets
+ the simulators and PODEM visit only the fanin or fanout of a wire instead of scanning the whole gate list.
+ The SCOAP testability measures of every wire are computed once after levelizing. CC0/CC1 estimate how hard it is to
+ set a wire to 0/1 from the primary inputs and CO how hard it is to observe it at a primary output (higher is harder).
+*/
+
+#ifndef CIRCUIT_H
+#define CIRCUIT_H
+
+#include <vector>
+#include <climits>
+#include "Classes.h"
+
+const unsigned NO_GATE = UINT_MAX; // Driver of a wire that is not the output of any gate (primary inputs).
+const unsigned SCOAP_INF = UINT_MAX / 4; // Testability of a wire that cannot be controlled or observed.
+
+class circuit {
+public:
+    // Per gate arrays, indexed by gate number.
+    vector<eGate> type;
+    vector<unsigned> outWire;
+    vector<unsigned> faninStart; // The inputs of gate g are faninWire[faninStart[g]] .. faninWire[faninStart[g+1]-1].
+    vector<unsigned> faninWire;
+    vector<unsigned> level; // Primary inputs are level 0, a gate is one level above its deepest input.
+    vector<unsigned> order; // Gate indices sorted by level (topological order).
+    vector<unsigned> levelStart; // order[levelStart[l]] .. order[levelStart[l+1]-1] are the gates of level l.
+
+    // Per wire arrays, indexed by wire ID.
+    vector<unsigned> driver;
+    vector<unsigned> fanoutStart; // The fanout gates of wire w are fanoutGate[fanoutStart[w]] .. fanoutGate[fanoutStart[w+1]-1].
+    vector<unsigned> fanoutGate;
+    vector<int> piIndex; // Position of the wire in PIs (inWires order) or -1.
+    vector<bool> poWire;
+    vector<unsigned> CC0, CC1, CO; // SCOAP measures (see computeScoap).
+
+    vector<unsigned> PIs;
+    vector<unsigned> POs;
+    unsigned maxLevel = 0;
+
+    void clear();
+    void addGate(eGate gType, const vector<unsigned> &wires); // The last wire is the output wire.
+    void addInput(unsigned wireID);
+    void addOutput(unsigned wireID);
+    bool levelize(); // Builds the fanout tables and levels. Returns false if the circuit has a combinational loop.
+    void computeScoap(); // Needs the levels from levelize.
+
+    unsigned numGates() const { return outWire.size(); }
+    unsigned numWires() const { return driver.size(); }
+    unsigned numFanin(unsigned g) const { return faninStart[g+1] - faninStart[g]; }
+    const unsigned* fanin(unsigned g) const { return faninWire.data() + faninStart[g]; }
+    unsigned numFanout(unsigned wireID) const {
+        return (wireID + 1 < fanoutStart.size()) ? fanoutStart[wireID+1] - fanoutStart[wireID] : 0;
+    }
+    const unsigned* fanout(unsigned wireID) const { return fanoutGate.data() + fanoutStart[wireID]; }
+    unsigned driverOf(unsigned wireID) const { return (wireID < driver.size()) ? driver[wireID] : NO_GATE; }
+    bool isPI(unsigned wireID) const { return (wireID < piIndex.size()) && (piIndex[wireID] >= 0); }
+    bool isPO(unsigned wireID) const { return (wireID < poWire.size()) && poWire[wireID]; }
+    bool hasWire(unsigned wireID) const { return (driverOf(wireID) != NO_GATE) || (numFanout(wireID) > 0); }
+
+private:
+    void growWires(unsigned wireID);
+};
+
+extern circuit ckt; // The circuit that was read by fileRead.
+
+#endif
@@ -0,0 +1,206 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Binary circuit image writer and loader (see cktimage.h).
+ Layout: the header, then every array as a uint64 element count followed by the elements, padded to 8 bytes.
+*/
+
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include "cktimage.h"
+#include "netlist.h"
+
+struct imageHeader {
+    char magic[8]; // "PODEMCKT"
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t sourceSize;
+    uint64_t sourceHash;
+    uint64_t imageSize; // Whole file, to catch truncated images.
+};
+
+static const char IMAGE_MAGIC[8] = {'P', 'O', 'D', 'E', 'M', 'C', 'K', 'T'};
+
+uint64_t checksum64 (const char* data, size_t len) {
+    // Word at a time multiply/rotate mix, much faster than a byte at a time hash on large netlists.
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t w;
+        memcpy(&w, data + i, 8);
+        h = (h ^ w) * 0xFF51AFD7ED558CCDULL;
+        h = (h << 31) | (h >> 33);
+    }
+    for (; i < len; i++) h = (h ^ (unsigned char) data[i]) * 0x100000001B3ULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    return h ^ (h >> 33);
+}
+
+// Appends one array (count, elements, padding) to the image buffer.
+template <typename T>
+static void putArray (string &buf, const T* data, uint64_t count) {
+    buf.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    buf.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+    buf.append((8 - buf.size() % 8) % 8, '\0');
+}
+
+template <typename T>
+static void putArray (string &buf, const vector<T> &v) { putArray(buf, v.data(), v.size()); }
+
+bool writeImage (const string &path, const circuit &c, uint64_t sourceSize, uint64_t sourceHash) {
+    string buf(sizeof(imageHeader), '\0');
+
+    vector<uint32_t> types(c.type.begin(), c.type.end());
+    vector<uint8_t> po(c.poWire.begin(), c.poWire.end());
+    putArray(buf, types);
+    putArray(buf, c.outWire);
+    putArray(buf, c.faninStart);
+    putArray(buf, c.faninWire);
+    putArray(buf, c.level);
+    putArray(buf, c.order);
+    putArray(buf, c.levelStart);
+    putArray(buf, c.driver);
+    putArray(buf, c.fanoutStart);
+    putArray(buf, c.fanoutGate);
+    putArray(buf, c.piIndex);
+    putArray(buf, po);
+    putArray(buf, c.PIs);
+    putArray(buf, c.POs);
+    putArray(buf, c.CC0);
+    putArray(buf, c.CC1);
+    putArray(buf, c.CO);
+    uint64_t maxLevel = c.maxLevel;
+    putArray(buf, &maxLevel, 1);
+
+    imageHeader h;
+    memcpy(h.magic, IMAGE_MAGIC, sizeof(h.magic));
+    h.version = CKT_IMAGE_VERSION;
+    h.headerSize = sizeof(imageHeader);
+    h.sourceSize = sourceSize;
+    h.sourceHash = sourceHash;
+    h.imageSize = buf.size();
+    memcpy(&buf[0], &h, sizeof(h));
+
+    // Write a temporary file and rename it, so a job that loads the image at the same time never sees half of it.
+    string tmp = path + ".tmp" + to_string(getpid());
+    FILE* out = fopen(tmp.c_str(), "wb");
+    if (!out) return false;
+    bool ok = fwrite(buf.data(), 1, buf.size(), out) == buf.size();
+    ok = (fclose(out) == 0) && ok;
+    if (ok) ok = rename(tmp.c_str(), path.c_str()) == 0;
+    if (!ok) remove(tmp.c_str());
+    return ok;
+}
+
+// Checks that every index in the arrays of an image (with consistent sizes) is in range, so a damaged image is parsed
+// again instead of crashing the simulators.
+static bool validContents (const circuit &c, const vector<uint32_t> &types, uint64_t maxLevel) {
+    size_t nG = c.outWire.size(), nW = c.driver.size();
+    auto monotonic = [](const vector<unsigned> &start, size_t size) {
+        if (start[0] != 0) return false;
+        for (size_t i = 1; i < start.size(); i++) {
+            if (start[i] < start[i - 1] || start[i] > size) return false;
+        }
+        return true;
+    };
+    auto wiresOk = [&](const vector<unsigned> &wires) {
+        for (auto w: wires) {
+            if (w >= nW) return false;
+        }
+        return true;
+    };
+    auto gatesOk = [&](const vector<unsigned> &gates) {
+        for (auto g: gates) {
+            if (g >= nG) return false;
+        }
+        return true;
+    };
+
+    for (auto t: types) {
+        eGate type = static_cast<eGate>(t);
+        if (type != INV && type != BUF && type != AND && type != NAND && type != OR && type != NOR) return false;
+    }
+    if (!monotonic(c.faninStart, c.faninWire.size()) || !monotonic(c.fanoutStart, c.fanoutGate.size()) ||
+        !monotonic(c.levelStart, nG)) return false;
+    if (!wiresOk(c.outWire) || !wiresOk(c.faninWire) || !wiresOk(c.PIs) || !wiresOk(c.POs)) return false;
+    if (!gatesOk(c.fanoutGate) || !gatesOk(c.order)) return false;
+    for (auto d: c.driver) {
+        if (d != NO_GATE && d >= nG) return false;
+    }
+    for (auto l: c.level) {
+        if (l > maxLevel) return false;
+    }
+    for (auto i: c.piIndex) {
+        if (i < -1 || i >= (int) c.PIs.size()) return false;
+    }
+    return true;
+}
+
+// Fills c from a mapped image. Returns false if the image does not belong to the given source or is damaged.
+static bool readImage (const mappedFile &img, circuit &c, uint64_t sourceSize, uint64_t sourceHash) {
+    if (img.size() < sizeof(imageHeader)) return false;
+    imageHeader h;
+    memcpy(&h, img.data(), sizeof(h));
+    if (memcmp(h.magic, IMAGE_MAGIC, sizeof(h.magic)) != 0 || h.version != CKT_IMAGE_VERSION) return false;
+    if (h.headerSize != sizeof(imageHeader) || h.imageSize != img.size()) return false;
+    if (h.sourceSize != sourceSize || h.sourceHash != sourceHash) return false; // The netlist changed.
+
+    const char* p = img.data() + sizeof(imageHeader);
+    const char* end = img.data() + img.size();
+    vector<uint32_t> types;
+    vector<uint8_t> po;
+    vector<uint64_t> maxLevel;
+    c.clear();
+    bool ok = getArray(p, end, types) && getArray(p, end, c.outWire) && getArray(p, end, c.faninStart) &&
+              getArray(p, end, c.faninWire) && getArray(p, end, c.level) && getArray(p, end, c.order) &&
+              getArray(p, end, c.levelStart) && getArray(p, end, c.driver) && getArray(p, end, c.fanoutStart) &&
+              getArray(p, end, c.fanoutGate) && getArray(p, end, c.piIndex) && getArray(p, end, po) &&
+              getArray(p, end, c.PIs) && getArray(p, end, c.POs) && getArray(p, end, c.CC0) &&
+              getArray(p, end, c.CC1) && getArray(p, end, c.CO) && getArray(p, end, maxLevel);
+    if (!ok || maxLevel.size() != 1) return false;
+
+    // The arrays have to fit together, otherwise the image is damaged.
+    size_t nG = c.outWire.size(), nW = c.driver.size();
+    ok = (types.size() == nG) && (c.faninStart.size() == nG + 1) && (c.level.size() == nG) && (c.order.size() == nG) &&
+         (c.faninStart.back() == c.faninWire.size()) && (c.levelStart.size() == maxLevel[0] + 2) &&
+         (c.fanoutStart.size() == nW + 1) && (c.fanoutStart.back() == c.fanoutGate.size()) &&
+         (c.piIndex.size() == nW) && (po.size() == nW) && (c.CC0.size() == c.CC1.size()) && (c.CO.size() == c.CC0.size());
+    ok = ok && (c.CC0.empty() || c.CC0.size() == nW) && validContents(c, types, maxLevel[0]);
+    if (!ok) {
+        c.clear();
+        return false;
+    }
+
+    c.type.resize(types.size());
+    for (unsigned g = 0; g < types.size(); g++) c.type[g] = static_cast<eGate>(types[g]);
+    c.poWire.assign(po.begin(), po.end());
+    c.maxLevel = maxLevel[0];
+    return true;
+}
+
+bool loadCircuit (const string &file, circuit &c, bool useImage) {
+    if (!useImage) return readCircuit(file, c);
+
+    uint64_t sourceSize, sourceHash;
+    {
+        mappedFile src(file);
+        if (!src.isOpen()) return readCircuit(file, c); // Let readCircuit report the problem.
+        sourceSize = src.size();
+        sourceHash = checksum64(src.data(), src.size());
+    }
+
+    string path = file + ".cimg";
+    {
+        mappedFile img(path);
+        if (img.isOpen() && readImage(img, c, sourceSize, sourceHash)) return true;
+    }
+
+    if (!readCircuit(file, c)) return false;
+    writeImage(path, c, sourceSize, sourceHash); // Not fatal if it fails (e.g. a read-only directory).
+    return true;
+}
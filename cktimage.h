@@ -0,0 +1,52 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Precompiled binary image of a levelized circuit, stored next to the circuit file as <file>.cimg. The image holds the
+ gate arrays, the fanin/fanout tables, the levels and topological order, the PI/PO lists and the SCOAP measures as
+ flat 8-byte aligned arrays behind a versioned header, together with the size and a checksum of the source netlist.
+ Loading a valid image memory maps it and copies the arrays straight into the circuit, skipping parsing, levelizing
+ and the SCOAP pass. If the source text changed (or the image is missing, from another version or damaged) the
+ netlist is parsed again and the image is rewritten. Images use the native byte order of the machine.
+*/
+
+#ifndef CKTIMAGE_H
+#define CKTIMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "circuit.h"
+
+const uint32_t CKT_IMAGE_VERSION = 1;
+
+// Loads file into c through its image when the image is current, otherwise with readCircuit (then the image is
+// regenerated if useImage is true). Returns false if the circuit could not be read.
+bool loadCircuit (const string &file, circuit &c, bool useImage);
+
+// Writes the image of c, built from a source file of the given size and checksum, to path.
+bool writeImage (const string &path, const circuit &c, uint64_t sourceSize, uint64_t sourceHash);
+
+// Checksum of the source text stored in the image.
+uint64_t checksum64 (const char* data, size_t len);
+
+// Reads the next array (count, elements, padding to 8 bytes) of a binary file into v. Returns false if it runs past the
+// end of the file. Also used for the pattern files (see patfile.h).
+template <typename T>
+bool getArray (const char* &p, const char* end, vector<T> &v) {
+    uint64_t count;
+    if (end - p < (ptrdiff_t) sizeof(count)) return false;
+    memcpy(&count, p, sizeof(count));
+    p += sizeof(count);
+    uint64_t bytes = count * sizeof(T);
+    if (count > (uint64_t) (end - p) / sizeof(T)) return false;
+    v.resize(count);
+    if (bytes) memcpy(v.data(), p, bytes);
+    p += bytes + (8 - bytes % 8) % 8;
+    return p <= end;
+}
+
+#endif
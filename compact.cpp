@@ -0,0 +1,119 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Dynamic compaction, cube merging and reverse order fault simulation of PODEM test sets (see compact.h).
+*/
+
+#include <algorithm>
+#include "compact.h"
+#include "ppsfp.h"
+#include "psim.h"
+
+vector<testCube> dynamicCompaction (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                    const vector<podemResult> &results, const podemOptions &pOptions,
+                                    const compactOptions &options) {
+    podemContext ctx(c);
+    ctx.options = pOptions;
+    ctx.options.backtracks = options.secondaryBacktracks;
+    if (c.CO.empty()) ctx.options.scoap = false;
+
+    vector<testCube> cubes;
+    vector<bool> covered(faults.size());
+    for (unsigned f = 0; f < faults.size(); f++) covered[f] = (results[f].status != DETECTED);
+
+    for (unsigned f = 0; f < faults.size(); f++) {
+        if (covered[f]) continue;
+        covered[f] = true;
+        testCube cube = results[f].test;
+
+        unsigned tries = 0;
+        for (unsigned s = f + 1; s < faults.size() && tries < options.secondaryFaults; s++) {
+            if (covered[s]) continue;
+            tries++;
+            if (cube.compatible(results[s].test)) { // The test of s already fits, no search needed.
+                cube.merge(results[s].test);
+                covered[s] = true;
+            }
+            else if (ctx.run(faults[s].first, faults[s].second, cube) == DETECTED) {
+                cube = ctx.test();
+                covered[s] = true;
+            }
+        }
+        cubes.push_back(cube);
+    }
+    return cubes;
+}
+
+vector<testCube> mergeCubes (const vector<testCube> &cubes) {
+    vector<testCube> merged;
+    for (auto &cube: cubes) {
+        bool done = false;
+        for (auto &m: merged) {
+            if (m.compatible(cube)) {
+                m.merge(cube);
+                done = true;
+                break;
+            }
+        }
+        if (!done) merged.push_back(cube);
+    }
+    return merged;
+}
+
+vector<testCube> reverseOrderCompaction (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                         const vector<testCube> &vecs) {
+    vector<testCube> reversed(vecs.rbegin(), vecs.rend());
+    vector<bool> keep(vecs.size(), false);
+    vector<bool> dropped(faults.size(), false);
+    ppsfp sim(c);
+    vector<uint64_t> piWords;
+
+    for (unsigned first = 0; first < reversed.size(); first += BLOCK_SIZE) {
+        unsigned count = min<unsigned>(BLOCK_SIZE, reversed.size() - first);
+        uint64_t mask = (count == BLOCK_SIZE) ? ~0ULL : ((1ULL << count) - 1);
+        packCubes(reversed, first, count, piWords);
+        sim.goodSim(piWords);
+
+        for (unsigned f = 0; f < faults.size(); f++) {
+            if (dropped[f]) continue;
+            uint64_t det = sim.detect(faults[f].first, faults[f].second, mask);
+            if (!det) continue;
+            dropped[f] = true;
+            keep[first + __builtin_ctzll(det)] = true; // The first vector of the reversed order that detects f.
+        }
+    }
+
+    vector<testCube> kept;
+    for (unsigned i = 0; i < vecs.size(); i++) {
+        if (keep[vecs.size() - 1 - i]) kept.push_back(vecs[i]);
+    }
+    return kept;
+}
+
+vector<vector<bool>> compactTests (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                   const vector<podemResult> &results, const podemOptions &pOptions,
+                                   const compactOptions &options, compactStats &stats) {
+    vector<testCube> cubes;
+    vector<pair<unsigned int, bool>> detected;
+    for (unsigned f = 0; f < faults.size(); f++) {
+        if (results[f].status != DETECTED) continue;
+        cubes.push_back(results[f].test);
+        detected.push_back(faults[f]);
+    }
+    stats.initial = cubes.size();
+
+    if (options.dynamic) cubes = dynamicCompaction(c, faults, results, pOptions, options);
+    stats.dynamic = cubes.size();
+
+    cubes = mergeCubes(cubes);
+    stats.merged = cubes.size();
+
+    cubes = reverseOrderCompaction(c, detected, cubes); // X is simulated as 0 like in callPODEM.
+    stats.final = cubes.size();
+    vector<vector<bool>> vecs;
+    for (auto &cube: cubes) vecs.push_back(cube.toVector());
+    return vecs;
+}
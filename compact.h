@@ -0,0 +1,57 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Test compaction of the vectors generated by PODEM. PODEM leaves most primary inputs of a test at X, so one vector per
+ fault wastes most of the tester time. Compaction shrinks the test set in three steps:
+ - Dynamic compaction: the test cube of a fault is kept open and PODEM is run again for the next undetected faults
+   with the specified bits of the cube fixed, so the secondary faults are detected with the remaining X inputs.
+ - Cube merging: cubes that do not conflict on any specified input are merged into one.
+ - Reverse order fault simulation: the filled vectors are fault simulated (PPSFP) from the last to the first, with
+   fault dropping, and every vector that detects no fault that a later vector has not already detected is dropped.
+*/
+
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include <vector>
+#include "circuit.h"
+#include "cube.h"
+#include "podem.h"
+
+struct compactOptions {
+    bool dynamic = true;
+    unsigned secondaryFaults = 32; // Secondary faults tried per cube during dynamic compaction.
+    unsigned secondaryBacktracks = 64; // PODEM backtrack limit for a secondary fault.
+};
+
+// Pattern count after every step of compactTests.
+struct compactStats {
+    unsigned initial = 0; // One vector per detected fault.
+    unsigned dynamic = 0;
+    unsigned merged = 0;
+    unsigned final = 0;
+};
+
+// Dynamic compaction. results[i] is the PODEM result of faults[i], the cubes of the detected faults are extended with
+// secondary faults. Returns the cubes.
+vector<testCube> dynamicCompaction (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                    const vector<podemResult> &results, const podemOptions &pOptions,
+                                    const compactOptions &options);
+
+// Greedily merges every cube into the first earlier cube that it is compatible with.
+vector<testCube> mergeCubes (const vector<testCube> &cubes);
+
+// Keeps the vectors (cubes with their X inputs at 0) that detect some fault of faults in reverse order fault simulation
+// (order is preserved).
+vector<testCube> reverseOrderCompaction (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                         const vector<testCube> &vecs);
+
+// All the steps above. X inputs of the final vectors are set to 0. The faults that PODEM did not detect are ignored.
+vector<vector<bool>> compactTests (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                   const vector<podemResult> &results, const podemOptions &pOptions,
+                                   const compactOptions &options, compactStats &stats);
+
+#endif
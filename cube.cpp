@@ -0,0 +1,95 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Packed ternary test cubes (see cube.h).
+*/
+
+#include "cube.h"
+
+void testCube::reset (unsigned numIn) {
+    numInputs = numIn;
+    care.assign((numIn + 63) / 64, 0);
+    value.assign(care.size(), 0);
+}
+
+void testCube::assign (unsigned numIn, const uint64_t* careWords, const uint64_t* valueWords) {
+    reset(numIn);
+    for (unsigned w = 0; w < care.size(); w++) care[w] = careWords[w];
+    if (numInputs % 64) care.back() &= (1ULL << (numInputs % 64)) - 1;
+    for (unsigned w = 0; w < care.size(); w++) value[w] = valueWords[w] & care[w]; // X inputs read as 0.
+}
+
+testCube testCube::fromVector (const vector<bool> &vec) {
+    testCube t(vec.size());
+    for (unsigned i = 0; i < vec.size(); i++) {
+        if (vec[i]) t.value[i >> 6] |= 1ULL << (i & 63);
+    }
+    t.fill(false);
+    return t;
+}
+
+unsigned testCube::numSpecified() const {
+    unsigned n = 0;
+    for (auto w: care) n += __builtin_popcountll(w);
+    return n;
+}
+
+bool testCube::compatible (const testCube &o) const {
+    for (unsigned w = 0; w < care.size(); w++) {
+        if (care[w] & o.care[w] & (value[w] ^ o.value[w])) return false;
+    }
+    return true;
+}
+
+void testCube::merge (const testCube &o) {
+    for (unsigned w = 0; w < care.size(); w++) {
+        value[w] |= o.value[w] & ~care[w];
+        care[w] |= o.care[w];
+    }
+}
+
+void testCube::fill (bool v) {
+    for (unsigned w = 0; w < care.size(); w++) {
+        if (v) value[w] |= ~care[w];
+        care[w] = ~0ULL;
+    }
+    // The last word only has numInputs % 64 inputs.
+    if (numInputs % 64) {
+        uint64_t last = (1ULL << (numInputs % 64)) - 1;
+        care.back() &= last;
+        value.back() &= last;
+    }
+}
+
+void testCube::fillRandom (patternRng &rng) {
+    for (unsigned w = 0; w < care.size(); w++) value[w] |= rng.next() & ~care[w];
+    fill(false);
+}
+
+vector<bool> testCube::toVector() const {
+    vector<bool> vec(numInputs);
+    for (unsigned i = 0; i < numInputs; i++) vec[i] = bit(i);
+    return vec;
+}
+
+string testCube::toString() const {
+    string s(numInputs, 'X');
+    for (unsigned i = 0; i < numInputs; i++) {
+        if (specified(i)) s[i] = bit(i) ? '1' : '0';
+    }
+    return s;
+}
+
+void packCubes (const vector<testCube> &cubes, unsigned first, unsigned count, vector<uint64_t> &piWords) {
+    unsigned numIn = cubes.empty() ? 0 : cubes[first].size();
+    piWords.assign(numIn, 0);
+    for (unsigned k = 0; k < count; k++) {
+        const testCube &t = cubes[first + k];
+        for (unsigned w = 0; w < t.numWords(); w++) {
+            for (uint64_t m = t.valueWords()[w]; m; m &= m - 1) piWords[64 * w + __builtin_ctzll(m)] |= 1ULL << k;
+        }
+    }
+}
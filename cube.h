@@ -0,0 +1,78 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Packed ternary test cube: one 0/1/X value per primary input, indexed by the dense PI position (circuit::piIndex,
+ assigned when the netlist is loaded). The cube is stored as two bit planes of 64 inputs per word, a care plane (the
+ input is specified) and a value plane, so every input takes 2 bits and compatibility, merging and filling are a few
+ word operations per 64 inputs. The value plane is 0 wherever the input is X, so it is the cube with its X inputs set
+ to 0 as it stands, and simulators read the filled vector from it without a copy.
+*/
+
+#ifndef CUBE_H
+#define CUBE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "circuit.h"
+#include "randpat.h"
+
+class testCube {
+public:
+    testCube() {}
+    explicit testCube (unsigned numInputs) { reset(numInputs); }
+    static testCube fromVector (const vector<bool> &vec);
+
+    void reset (unsigned numInputs); // numInputs inputs, all X.
+    void assign (unsigned numInputs, const uint64_t* careWords, const uint64_t* valueWords); // From packed planes.
+    unsigned size() const { return numInputs; }
+    bool empty() const { return !numInputs; }
+
+    bool specified (unsigned i) const { return (care[i >> 6] >> (i & 63)) & 1; }
+    bool bit (unsigned i) const { return (value[i >> 6] >> (i & 63)) & 1; } // 0 for X.
+    int8_t get (unsigned i) const { return specified(i) ? bit(i) : -1; } // 0, 1 or -1 for X.
+    void set (unsigned i, bool v) {
+        uint64_t m = 1ULL << (i & 63);
+        care[i >> 6] |= m;
+        value[i >> 6] = v ? (value[i >> 6] | m) : (value[i >> 6] & ~m);
+    }
+    unsigned numSpecified() const;
+
+    // Calls f(i, v) for every specified input in index order, skipping 64 X inputs at a time.
+    template <class F> void forEachSpecified (F f) const {
+        for (unsigned w = 0; w < care.size(); w++) {
+            for (uint64_t m = care[w]; m; m &= m - 1) {
+                unsigned i = 64 * w + __builtin_ctzll(m);
+                f(i, bit(i));
+            }
+        }
+    }
+
+    // Two cubes are compatible if no input is 0 in one and 1 in the other.
+    bool compatible (const testCube &o) const;
+    void merge (const testCube &o); // Specifies the X inputs that o specifies (the cubes must be compatible).
+    void fill (bool v); // Every X input becomes v.
+    void fillRandom (patternRng &rng);
+
+    // The planes, (size() + 63) / 64 words each. Bits past size() are 0.
+    unsigned numWords() const { return care.size(); }
+    const uint64_t* careWords() const { return care.data(); }
+    const uint64_t* valueWords() const { return value.data(); }
+
+    vector<bool> toVector() const; // X inputs as 0.
+    string toString() const; // One 0, 1 or X per input.
+    bool operator== (const testCube &o) const { return numInputs == o.numInputs && care == o.care && value == o.value; }
+
+private:
+    unsigned numInputs = 0;
+    vector<uint64_t> care, value;
+};
+
+// Packs cubes[first] .. cubes[first+count-1] (count <= 64, X inputs as 0) into one pattern word per primary input, like
+// packVectors. Only the 1 bits of the value planes are visited.
+void packCubes (const vector<testCube> &cubes, unsigned first, unsigned count, vector<uint64_t> &piWords);
+
+#endif
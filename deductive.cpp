@@ -0,0 +1,159 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Deductive fault simulation with arena-allocated sorted fault lists (see deductive.h).
+ For a gate with controlling value c, the output list is the union of the input lists if no input is at c, otherwise
+ the intersection of the lists of the inputs at c minus the lists of the other inputs. The fault of the output wire
+ that the good value excites is added last.
+*/
+
+#include <algorithm>
+#include "deductive.h"
+
+void deductiveSim::setFaults (const vector<pair<unsigned int, bool>> &faults) {
+    vector<unsigned> ids(faults.size());
+    for (unsigned f = 0; f < faults.size(); f++) ids[f] = f;
+    setFaults(faults, ids, ids);
+}
+
+void deductiveSim::setFaults (const vector<pair<unsigned int, bool>> &faults, const vector<unsigned> &classes,
+                              const vector<unsigned> &classRep) {
+    faultList = faults;
+    classOf = classes;
+    localClass.assign(2 * c.numWires(), -1);
+    for (unsigned k = 0; k < classRep.size(); k++) {
+        auto f = faultList[classRep[k]];
+        if (f.first < c.numWires()) localClass[2 * f.first + f.second] = k;
+    }
+    detectedBits.assign((classRep.size() + 63) / 64, 0);
+    droppedBits.assign(detectedBits.size(), 0);
+    val.assign(c.numWires(), 0);
+    listStart.assign(c.numWires(), 0);
+    listSize.assign(c.numWires(), 0);
+}
+
+void deductiveSim::dropDetected() {
+    for (unsigned i = 0; i < droppedBits.size(); i++) droppedBits[i] |= detectedBits[i];
+}
+
+void deductiveSim::clearDropped() {
+    droppedBits.assign(droppedBits.size(), 0);
+}
+
+void deductiveSim::setList (unsigned wireID, const uint32_t* first, size_t n) {
+    listStart[wireID] = arena.size();
+    listSize[wireID] = n;
+    arena.insert(arena.end(), first, first + n);
+}
+
+// Adds the fault of wireID that its good value excites (stuck at the opposite value) to the list of the wire.
+void deductiveSim::inject (unsigned wireID) {
+    int k = localClass[2 * wireID + !val[wireID]];
+    if (k < 0 || ((droppedBits[k / 64] >> (k % 64)) & 1)) return;
+
+    uint32_t start = listStart[wireID], n = listSize[wireID];
+    uint32_t pos = lower_bound(arena.begin() + start, arena.begin() + start + n, (uint32_t) k) - arena.begin() - start;
+    if (pos < n && arena[start + pos] == (uint32_t) k) return;
+
+    // The list may be shared with an input wire, so the new one is written behind the arena.
+    uint32_t newStart = arena.size();
+    arena.resize(newStart + n + 1);
+    copy(arena.begin() + start, arena.begin() + start + pos, arena.begin() + newStart);
+    arena[newStart + pos] = k;
+    copy(arena.begin() + start + pos, arena.begin() + start + n, arena.begin() + newStart + pos + 1);
+    listStart[wireID] = newStart;
+    listSize[wireID] = n + 1;
+}
+
+void deductiveSim::combine (unsigned g) {
+    const unsigned* in = c.fanin(g);
+    unsigned n = c.numFanin(g);
+    unsigned out = c.outWire[g];
+    eGate type = c.type[g];
+    bool inv = (type == NAND) || (type == NOR) || (type == INV);
+
+    // The result is either one of the input lists in the arena (shared) or the last merge in scratch.
+    const uint32_t* p = arena.data() + listStart[in[0]];
+    size_t size = listSize[in[0]];
+    bool shared = true;
+    uint32_t sharedStart = listStart[in[0]];
+    auto merge = [&](unsigned wireID, int op) {
+        const uint32_t* q = arena.data() + listStart[wireID];
+        size_t m = listSize[wireID];
+        scratch2.resize(size + m);
+        uint32_t* end;
+        if (op == 0) end = set_union(p, p + size, q, q + m, scratch2.data());
+        else if (op == 1) end = set_intersection(p, p + size, q, q + m, scratch2.data());
+        else end = set_difference(p, p + size, q, q + m, scratch2.data());
+        scratch2.resize(end - scratch2.data());
+        swap(scratch, scratch2);
+        p = scratch.data();
+        size = scratch.size();
+        shared = false;
+    };
+
+    if (type == INV || type == BUF) val[out] = val[in[0]] ^ inv;
+    else {
+        bool ctrl = (type == OR) || (type == NOR);
+        int first = -1; // First input at the controlling value.
+        for (unsigned i = 0; i < n && first < 0; i++) {
+            if (val[in[i]] == ctrl) first = i;
+        }
+
+        if (first < 0) { // No input at the controlling value: a fault on any input flips the output.
+            val[out] = !ctrl ^ inv;
+            for (unsigned i = 1; i < n; i++) {
+                if (!listSize[in[i]]) continue;
+                if (!size) {
+                    p = arena.data() + listStart[in[i]];
+                    size = listSize[in[i]];
+                    sharedStart = listStart[in[i]];
+                }
+                else merge(in[i], 0);
+            }
+        }
+        else { // Only faults that flip every controlling input and no other input flip the output.
+            val[out] = ctrl ^ inv;
+            p = arena.data() + listStart[in[first]];
+            size = listSize[in[first]];
+            sharedStart = listStart[in[first]];
+            for (unsigned i = first + 1; i < n && size; i++) {
+                if (val[in[i]] == ctrl && in[i] != in[first]) merge(in[i], 1);
+            }
+            for (unsigned i = 0; i < n && size; i++) {
+                if (val[in[i]] != ctrl && listSize[in[i]]) merge(in[i], 2);
+            }
+        }
+    }
+
+    if (shared) {
+        listStart[out] = sharedStart;
+        listSize[out] = size;
+    }
+    else setList(out, p, size);
+    inject(out);
+}
+
+const vector<unsigned> &deductiveSim::simulate (const vector<bool> &vec) {
+    arena.clear();
+    fill(listSize.begin(), listSize.end(), 0);
+    for (unsigned i = 0; i < c.PIs.size(); i++) {
+        val[c.PIs[i]] = vec[i];
+        inject(c.PIs[i]);
+    }
+    for (auto g: c.order) combine(g);
+
+    fill(detectedBits.begin(), detectedBits.end(), 0);
+    for (auto w: c.POs) {
+        const uint32_t* l = arena.data() + listStart[w];
+        for (uint32_t i = 0; i < listSize[w]; i++) detectedBits[l[i] / 64] |= 1ULL << (l[i] % 64);
+    }
+    detected.clear();
+    for (unsigned f = 0; f < faultList.size(); f++) {
+        if ((detectedBits[classOf[f] / 64] >> (classOf[f] % 64)) & 1) detected.push_back(f);
+    }
+    return detected;
+}
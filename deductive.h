@@ -0,0 +1,65 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Deductive fault simulator over the levelized circuit. Every wire carries the list of faults that would flip its value
+ for the current vector; the lists are sorted arrays of fault class IDs (32 bits per entry) that live in one arena per
+ vector, so a vector costs no allocation once the arena has grown and the whole state is reset by emptying the arena.
+ The lists of a gate are combined with merges (union, intersection and difference of sorted ranges), a gate output
+ that only passes one input list on shares it instead of copying it, and the faults reaching the primary outputs are
+ collected in a bitset indexed by class ID.
+ Faults that are detected by exactly the same tests can share one class ID (e.g. the equivalence classes of faultSet),
+ then only the representative of the class is injected and a detection is reported for every fault of the class.
+*/
+
+#ifndef DEDUCTIVE_H
+#define DEDUCTIVE_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+
+class deductiveSim {
+public:
+    explicit deductiveSim (const circuit &cRef) : c(cRef) {}
+
+    // Faults to simulate (sorted by wire ID then stuck-at value). classOf[i] is the class ID of faults[i] and
+    // classRep[k] the index of the fault of class k that is injected. Without classes every fault is its own class.
+    void setFaults (const vector<pair<unsigned int, bool>> &faultList);
+    void setFaults (const vector<pair<unsigned int, bool>> &faultList, const vector<unsigned> &classOf,
+                    const vector<unsigned> &classRep);
+
+    // Simulates one vector (in inWires order) and returns the indices (into the fault list, ascending) of the faults
+    // that it detects and that were not dropped.
+    const vector<unsigned> &simulate (const vector<bool> &vec);
+
+    // The faults detected by the last vector are no longer injected (they stay detected in dropped()).
+    void dropDetected();
+    void clearDropped();
+    bool dropped (unsigned f) const { return (droppedBits[classOf[f] / 64] >> (classOf[f] % 64)) & 1; }
+
+    const vector<pair<unsigned int, bool>> &faults() const { return faultList; }
+    const vector<uint8_t> &values() const { return val; } // Good value of every wire for the last vector.
+    size_t arenaSize() const { return arena.capacity(); } // Entries the largest vector so far needed.
+
+private:
+    void combine (unsigned g); // Good value and fault list of the output of gate g.
+    void setList (unsigned wireID, const uint32_t* first, size_t n);
+    void inject (unsigned wireID);
+
+    const circuit &c;
+    vector<pair<unsigned int, bool>> faultList;
+    vector<unsigned> classOf;
+    vector<int> localClass; // localClass[2*w + sa] is the class injected for w s-a-sa, or -1.
+    vector<uint64_t> detectedBits, droppedBits; // Bitsets of class IDs.
+    vector<unsigned> detected;
+
+    vector<uint8_t> val;
+    vector<uint32_t> arena; // Fault lists of the current vector.
+    vector<uint32_t> listStart, listSize; // Fault list of wire w is arena[listStart[w]] .. (listSize[w] entries).
+    vector<uint32_t> scratch, scratch2; // Merge buffers.
+};
+
+#endif
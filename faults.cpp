@@ -0,0 +1,135 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Fault universe construction and structural equivalence/dominance collapsing (see faults.h).
+*/
+
+#include "faults.h"
+
+// Union-find root with path halving.
+static unsigned findRoot (vector<unsigned> &parent, unsigned x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+int faultSet::index (unsigned wireID, bool sa) const {
+    if (wireID >= wireIndex.size() || wireIndex[wireID] < 0) return -1;
+    return wireIndex[wireID] + sa;
+}
+
+void faultSet::build (const circuit &c) {
+    universe.clear();
+    wireIndex.assign(c.numWires(), -1);
+    for (unsigned w = 0; w < c.numWires(); w++) {
+        if (c.isPI(w) || c.driverOf(w) != NO_GATE) {
+            wireIndex[w] = universe.size();
+            universe.push_back(make_pair(w, false));
+            universe.push_back(make_pair(w, true));
+        }
+    }
+
+    unsigned numFaults = universe.size();
+    vector<unsigned> parent(numFaults);
+    for (unsigned f = 0; f < numFaults; f++) parent[f] = f;
+    auto unite = [&](int a, int b) {
+        if (a < 0 || b < 0) return;
+        parent[findRoot(parent, a)] = findRoot(parent, b);
+    };
+
+    vector<vector<unsigned>> dom(numFaults); // Dominating input faults, collected on the dropped output fault.
+    vector<unsigned> freeIn;
+    for (unsigned g = 0; g < c.numGates(); g++) {
+        unsigned o = c.outWire[g];
+        const unsigned* in = c.fanin(g);
+        unsigned n = c.numFanin(g);
+
+        // Only fanout-free inputs (a single branch that is not observed anywhere else) share tests with the output.
+        freeIn.clear();
+        for (unsigned i = 0; i < n; i++) {
+            unsigned uses = 0;
+            for (unsigned j = 0; j < n; j++) uses += (in[j] == in[i]);
+            if (uses == 1 && c.numFanout(in[i]) == 1 && !c.isPO(in[i]) && index(in[i], false) >= 0) freeIn.push_back(in[i]);
+        }
+        if (freeIn.empty()) continue;
+
+        // Input fault at the controlling value is equivalent to the output fault at the controlled value, and the
+        // output fault at the other value dominates every input fault at the non-controlling value.
+        bool cv, inverting;
+        switch (c.type[g]) {
+            case AND:  cv = false; inverting = false; break;
+            case NAND: cv = false; inverting = true;  break;
+            case OR:   cv = true;  inverting = false; break;
+            case NOR:  cv = true;  inverting = true;  break;
+            case INV:
+                unite(index(freeIn[0], false), index(o, true));
+                unite(index(freeIn[0], true), index(o, false));
+                continue;
+            default: // BUF
+                unite(index(freeIn[0], false), index(o, false));
+                unite(index(freeIn[0], true), index(o, true));
+                continue;
+        }
+
+        bool outCtrl = cv ^ inverting;
+        for (auto w: freeIn) {
+            unite(index(w, cv), index(o, outCtrl));
+            dom[index(o, !outCtrl)].push_back(index(w, !cv));
+        }
+    }
+
+    // The representative of a class is its lowest universe index. Dominance information moves to the representative.
+    rep.assign(numFaults, 0);
+    vector<unsigned> lowest(numFaults, numFaults);
+    for (unsigned f = 0; f < numFaults; f++) {
+        unsigned r = findRoot(parent, f);
+        if (f < lowest[r]) lowest[r] = f;
+    }
+    for (unsigned f = 0; f < numFaults; f++) rep[f] = lowest[findRoot(parent, f)];
+
+    domBy.assign(numFaults, vector<unsigned>());
+    vector<bool> classDropped(numFaults, false);
+    for (unsigned f = 0; f < numFaults; f++) {
+        if (dom[f].empty()) continue;
+        classDropped[rep[f]] = true;
+        domBy[rep[f]].insert(domBy[rep[f]].end(), dom[f].begin(), dom[f].end());
+    }
+
+    dropped.assign(numFaults, false);
+    targets.clear();
+    for (unsigned f = 0; f < numFaults; f++) {
+        dropped[f] = classDropped[rep[f]];
+        if (rep[f] == f && !dropped[f]) targets.push_back(f);
+    }
+}
+
+vector<int> faultSet::expand (const vector<int> &targetFirst) const {
+    unsigned numFaults = universe.size();
+    vector<int> classFirst(numFaults, -1);
+    for (unsigned t = 0; t < targets.size(); t++) classFirst[targets[t]] = targetFirst[t];
+
+    // A dropped class is detected as soon as one of its dominated faults is. Those faults can be dropped themselves
+    // (chains of gates in a fanout-free region), so iterate until nothing changes.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned r = 0; r < numFaults; r++) {
+            for (auto d: domBy[r]) {
+                int v = classFirst[rep[d]];
+                if (v >= 0 && (classFirst[r] < 0 || v < classFirst[r])) {
+                    classFirst[r] = v;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    vector<int> first(numFaults);
+    for (unsigned f = 0; f < numFaults; f++) first[f] = classFirst[rep[f]];
+    return first;
+}
@@ -0,0 +1,44 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Fault universe of the 'a' mode (both stuck-at faults of every primary input and every gate output wire) and its
+ structurally collapsed target list.
+ Equivalence collapsing merges the input and output faults of a gate that are detected by exactly the same tests
+ (e.g. AND input s-a-0 and output s-a-0). Dominance collapsing then drops the output fault of a gate that is detected by
+ every test of one of its input faults (e.g. AND output s-a-1 is detected by any test for an input s-a-1).
+ The simulators model stuck-at faults on wires (fanout stems), so a fault on a wire with more than one fanout (or a
+ wire that is also a primary output) is never merged with the faults of the gates it feeds: the corresponding branch
+ faults are not part of the universe.
+ Coverage is reported against the uncollapsed universe with expand, which gives every fault of a class the detection
+ of its representative and credits a dominance-dropped fault once one of its dominated input faults is detected (so
+ it is a lower bound for the dropped faults).
+*/
+
+#ifndef FAULTS_H
+#define FAULTS_H
+
+#include <vector>
+#include "circuit.h"
+
+class faultSet {
+public:
+    vector<pair<unsigned int, bool>> universe; // Sorted by wire ID then stuck-at value.
+    vector<unsigned> rep; // Universe index of the representative of each fault's equivalence class.
+    vector<bool> dropped; // True if the fault's class was removed by dominance collapsing.
+    vector<unsigned> targets; // Universe indices of the class representatives that have to be simulated.
+
+    void build (const circuit &c);
+    int index (unsigned wireID, bool sa) const; // Universe index of a fault, or -1 if it is not in the universe.
+
+    // targetFirst[t] is the first vector that detected targets[t] (-1 if none). Returns the same for every universe fault.
+    vector<int> expand (const vector<int> &targetFirst) const;
+
+private:
+    vector<int> wireIndex; // Universe index of the s-a-0 fault of each wire (the s-a-1 fault follows it), or -1.
+    vector<vector<unsigned>> domBy; // Universe faults whose tests detect a dropped fault.
+};
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel fault simulation over (vector block, fault chunk) items (see faultsim.h).
+*/
+
+#include "faultsim.h"
+
+const unsigned FAULT_CHUNK = 64; // Faults per work item.
+
+parallelFaultSim::parallelFaultSim (const circuit &cRef, const compiledCircuit &tRef, unsigned numThreads)
+    : pool(numThreads ? numThreads : 1) {
+    for (unsigned i = 0; i < pool.size(); i++) workers.emplace_back(new workerState(cRef, tRef));
+    width = workers[0]->sim.bits();
+    words = workers[0]->sim.words();
+    for (auto &w: workers) w->det.resize(words);
+}
+
+void parallelFaultSim::prepare (const vector<vector<bool>> &vecs, unsigned first, unsigned count) {
+    unsigned numBlocks = (count + width - 1) / width;
+    blockWords.resize(numBlocks);
+    blockMask.assign(numBlocks, vector<uint64_t>(words, 0));
+    pool.parallelFor(numBlocks, [&](unsigned b, unsigned) {
+        unsigned n = min(width, count - b * width);
+        packWide(vecs, first + b * width, n, words, blockWords[b]);
+        for (unsigned k = 0; k < n; k++) blockMask[b][k / 64] |= 1ULL << (k % 64);
+    });
+    for (auto &w: workers) w->block = -1;
+}
+
+wideFaultSim &parallelFaultSim::simFor (unsigned block, unsigned worker) {
+    workerState &w = *workers[worker];
+    if (w.block != (int) block) {
+        w.sim.goodSim(blockWords[block]);
+        w.block = block;
+    }
+    return w.sim;
+}
+
+void parallelFaultSim::detectAll (const vector<pair<unsigned int, bool>> &faults, const vector<vector<bool>> &vecs,
+                                  unsigned first, unsigned count, vector<uint64_t> &det) {
+    unsigned perFault = wordsPer(count);
+    det.assign(faults.size() * perFault, 0);
+    if (!count || faults.empty()) return;
+    prepare(vecs, first, count);
+
+    unsigned chunks = (faults.size() + FAULT_CHUNK - 1) / FAULT_CHUNK;
+    pool.parallelFor(blockWords.size() * chunks, [&](unsigned i, unsigned worker) {
+        unsigned b = i / chunks, end = min<unsigned>(faults.size(), (i % chunks + 1) * FAULT_CHUNK);
+        wideFaultSim &sim = simFor(b, worker);
+        uint64_t* d = workers[worker]->det.data();
+        unsigned valid = min(words, perFault - b * words); // The last block can be shorter.
+        for (unsigned f = (i % chunks) * FAULT_CHUNK; f < end; f++) {
+            sim.detect(faults[f].first, faults[f].second, blockMask[b].data(), d);
+            for (unsigned l = 0; l < valid; l++) det[f * perFault + b * words + l] = d[l];
+        }
+    });
+}
+
+vector<int> parallelFaultSim::firstDetection (const vector<pair<unsigned int, bool>> &faults,
+                                               const vector<vector<bool>> &vecs) {
+    vector<int> first(faults.size(), -1);
+    if (vecs.empty() || faults.empty()) return first;
+    prepare(vecs, 0, vecs.size());
+
+    // One block at a time, so a fault is never simulated after the block that detects it. The live faults are split
+    // into enough chunks to keep every worker busy.
+    vector<unsigned> live(faults.size());
+    for (unsigned f = 0; f < faults.size(); f++) live[f] = f;
+    for (unsigned b = 0; b < blockWords.size() && !live.empty(); b++) {
+        unsigned chunk = max(1u, min<unsigned>(FAULT_CHUNK, live.size() / (4 * pool.size())));
+        unsigned items = (live.size() + chunk - 1) / chunk;
+        pool.parallelFor(items, [&](unsigned i, unsigned worker) {
+            wideFaultSim &sim = simFor(b, worker);
+            uint64_t* d = workers[worker]->det.data();
+            unsigned end = min<unsigned>(live.size(), (i + 1) * chunk);
+            for (unsigned j = i * chunk; j < end; j++) {
+                unsigned f = live[j];
+                sim.detect(faults[f].first, faults[f].second, blockMask[b].data(), d);
+                for (unsigned l = 0; l < words; l++) {
+                    if (d[l]) {
+                        first[f] = b * width + 64 * l + __builtin_ctzll(d[l]);
+                        break;
+                    }
+                }
+            }
+        });
+
+        // Fault dropping for the next blocks, in the order of the fault list.
+        unsigned kept = 0;
+        for (auto f: live) {
+            if (first[f] < 0) live[kept++] = f;
+        }
+        live.resize(kept);
+    }
+    return first;
+}
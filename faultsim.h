@@ -0,0 +1,62 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel fault simulation driver. The vectors are split into blocks as wide as the SIMD kernel (see simd.h) and the
+ fault list into chunks, and the chunks are the items of the work-stealing thread pool. Every worker owns a wideFaultSim,
+ so all the scratch state of the event driven propagation is private, and only simulates the good machine again when
+ it moves to another block.
+ detectAll gives every detection of every fault, with the (block, chunk) pairs as items numbered block by block.
+ firstDetection drops faults: it runs the blocks one after the other and the faults that a block detects are removed
+ from the list that every thread works on for the next blocks.
+ Results are written without a lock, since every item owns the entries of its own faults, and they are the same
+ whatever the thread count and the order the items ran in.
+*/
+
+#ifndef FAULTSIM_H
+#define FAULTSIM_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "circuit.h"
+#include "simd.h"
+#include "tape.h"
+#include "threadpool.h"
+
+class parallelFaultSim {
+public:
+    parallelFaultSim (const circuit &cRef, const compiledCircuit &tRef, unsigned numThreads);
+
+    // Every detection of vectors first .. first+count-1: bit k of det[f * wordsPer(count) + k/64] is set if vector
+    // first+k detects faults[f].
+    void detectAll (const vector<pair<unsigned int, bool>> &faults, const vector<vector<bool>> &vecs, unsigned first,
+                    unsigned count, vector<uint64_t> &det);
+    static unsigned wordsPer (unsigned count) { return (count + 63) / 64; }
+
+    // Index of the first vector that detects each fault (-1 if none), with fault dropping.
+    vector<int> firstDetection (const vector<pair<unsigned int, bool>> &faults, const vector<vector<bool>> &vecs);
+
+    unsigned threads() const { return pool.size(); }
+
+private:
+    struct workerState {
+        workerState (const circuit &c, const compiledCircuit &t) : sim(c, t) {}
+        wideFaultSim sim;
+        int block = -1; // Block whose good machine values sim holds.
+        vector<uint64_t> det;
+    };
+
+    void prepare (const vector<vector<bool>> &vecs, unsigned first, unsigned count);
+    wideFaultSim &simFor (unsigned block, unsigned worker);
+
+    threadPool pool;
+    vector<unique_ptr<workerState>> workers;
+    unsigned width, words; // Vectors and pattern words per block.
+    vector<vector<uint64_t>> blockWords; // Packed PI words of every block (packWide layout).
+    vector<vector<uint64_t>> blockMask; // Valid vectors of every block.
+};
+
+#endif
@@ -0,0 +1,164 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel-fault simulator and test generation with fault dropping (see fpsim.h).
+*/
+
+#include <mutex>
+#include "fpsim.h"
+#include "psim.h"
+
+faultParallelSim::faultParallelSim (const circuit &cRef) : c(cRef) {
+    good.assign(c.numWires(), 0);
+    val.assign(c.numWires(), 0);
+    force0.assign(c.numWires(), 0);
+    force1.assign(c.numWires(), 0);
+    levelQueue.resize(c.maxLevel + 1);
+    queued.assign(c.numGates(), false);
+}
+
+void faultParallelSim::goodSim (const testCube &vec) {
+    vector<uint64_t> piWords(c.PIs.size());
+    for (unsigned i = 0; i < piWords.size(); i++) piWords[i] = 0 - (uint64_t) vec.bit(i); // All ones or all zeros.
+    simBlock(c, piWords, good);
+    val = good;
+}
+
+void faultParallelSim::schedule (unsigned wireID) {
+    const unsigned* fo = c.fanout(wireID);
+    for (unsigned i = 0; i < c.numFanout(wireID); i++) {
+        unsigned g = fo[i];
+        if (queued[g]) continue;
+        queued[g] = true;
+        unsigned l = c.level[g];
+        levelQueue[l].push_back(g);
+        if (l < low) low = l;
+        if (l > high) high = l;
+    }
+}
+
+// Simulates the faults ids[0..n-1] (n <= 64) as bits 0..n-1 and returns the bits of the detected ones.
+uint64_t faultParallelSim::group (const vector<pair<unsigned int, bool>> &faults, const unsigned* ids, unsigned n) {
+    // Only the faults that the vector excites are injected, the others cannot be detected.
+    for (unsigned k = 0; k < n; k++) {
+        unsigned w = faults[ids[k]].first;
+        bool sa = faults[ids[k]].second;
+        if ((good[w] & 1) == sa) continue;
+        if (!force0[w] && !force1[w]) sites.push_back(w);
+        if (sa) force1[w] |= 1ULL << k;
+        else force0[w] |= 1ULL << k;
+    }
+    if (sites.empty()) return 0;
+
+    low = c.maxLevel + 1;
+    high = 0;
+    for (auto w: sites) {
+        val[w] = (good[w] & ~force0[w]) | force1[w];
+        touched.push_back(w);
+        schedule(w);
+    }
+
+    // Level by level, so every gate is evaluated once with its final inputs. A fault site keeps its stuck value even
+    // when the gate that drives it sees another fault of the group.
+    for (unsigned l = low; l <= high && l <= c.maxLevel; l++) {
+        for (unsigned i = 0; i < levelQueue[l].size(); i++) {
+            unsigned g = levelQueue[l][i];
+            queued[g] = false;
+            unsigned out = c.outWire[g];
+            uint64_t v = (evalGate(c, g, val.data()) & ~force0[out]) | force1[out];
+            if (v == val[out]) continue; // No faulty machine changed at this gate.
+
+            val[out] = v;
+            touched.push_back(out);
+            schedule(out);
+        }
+        levelQueue[l].clear();
+    }
+
+    uint64_t detected = 0;
+    for (auto w: touched) {
+        if (c.isPO(w)) detected |= val[w] ^ good[w];
+    }
+
+    // Back to the good machine for the next group.
+    for (auto w: touched) val[w] = good[w];
+    for (auto w: sites) force0[w] = force1[w] = 0;
+    touched.clear();
+    sites.clear();
+    return detected;
+}
+
+void faultParallelSim::detect (const vector<pair<unsigned int, bool>> &faults, const vector<unsigned> &ids,
+                               vector<unsigned> &detected) {
+    for (unsigned first = 0; first < ids.size(); first += 64) {
+        unsigned n = min<unsigned>(64, ids.size() - first);
+        uint64_t det = group(faults, ids.data() + first, n);
+        while (det) {
+            detected.push_back(ids[first + __builtin_ctzll(det)]);
+            det &= det - 1;
+        }
+    }
+}
+
+vector<podemResult> runPODEMDropping (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                      unsigned numThreads, const podemOptions &options, const staticLearning *learned,
+                                      vector<int> &source) {
+    vector<podemResult> results(faults.size());
+    source.assign(faults.size(), -1);
+    podemPool pool(c, numThreads, options, learned);
+    faultParallelSim sim(c);
+
+    enum {WAITING, RUNNING, DONE};
+    vector<uint8_t> state(faults.size(), WAITING);
+
+    // Faults that a test can still drop: not detected yet and not proven redundant (aborted faults stay in). The
+    // faults that PODEM is working on stay in the list but are not simulated.
+    vector<unsigned> live(faults.size());
+    for (unsigned f = 0; f < faults.size(); f++) live[f] = f;
+    vector<unsigned> ids, detected;
+
+    mutex m; // Guards everything above. A test is fault simulated while it is held, PODEM runs without it.
+    unsigned cursor = 0;
+
+    auto next = [&]() -> int {
+        lock_guard<mutex> lock(m);
+        while (cursor < faults.size() && source[cursor] >= 0) cursor++; // Dropped by an earlier test.
+        if (cursor == faults.size()) return -1;
+        state[cursor] = RUNNING;
+        return cursor++;
+    };
+
+    auto done = [&](unsigned f, podemResult &r) {
+        lock_guard<mutex> lock(m);
+        results[f] = move(r);
+        state[f] = DONE;
+        if (results[f].status == DETECTED) source[f] = f;
+
+        unsigned kept = 0;
+        ids.clear();
+        for (auto l: live) {
+            if (source[l] >= 0 || (state[l] == DONE && results[l].status == REDUNDANT)) continue;
+            live[kept++] = l;
+            if (state[l] != RUNNING) ids.push_back(l);
+        }
+        live.resize(kept);
+        if (results[f].status != DETECTED || ids.empty()) return;
+
+        testCube vec = results[f].test;
+        vec.fill(false);
+        sim.goodSim(vec);
+        detected.clear();
+        sim.detect(faults, ids, detected);
+        for (auto d: detected) {
+            source[d] = f;
+            results[d].status = DETECTED;
+            results[d].test = vec;
+        }
+    };
+
+    pool.runQueue(faults, next, done);
+    return results;
+}
@@ -0,0 +1,62 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel-fault simulation of a single vector: bit k of every word is the value of faulty machine k, so 64 faults are
+ simulated in one pass. The good machine is simulated once per vector (every bit holds the good value), then for each
+ group of 64 faults the excited fault sites are forced to their stuck values and only the gates whose inputs differ
+ from the good machine are evaluated, event driven and in level order, through the union of the fanout cones. A fault
+ is detected if its bit differs from the good machine on some primary output.
+ runPODEMDropping uses it to drop faults during test generation: every PODEM worker takes the next fault that is
+ still undetected, and every test it returns is simulated right away against all of them, so a fault that an earlier
+ test detects never goes to PODEM.
+*/
+
+#ifndef FPSIM_H
+#define FPSIM_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+#include "cube.h"
+#include "learn.h"
+#include "podem.h"
+
+class faultParallelSim {
+public:
+    explicit faultParallelSim (const circuit &cRef);
+
+    // Simulates the good machine for one vector, the cube with its X inputs at 0.
+    void goodSim (const testCube &vec);
+
+    // Appends to detected the entries of ids (indices into faults) whose fault the current vector detects.
+    void detect (const vector<pair<unsigned int, bool>> &faults, const vector<unsigned> &ids, vector<unsigned> &detected);
+
+private:
+    uint64_t group (const vector<pair<unsigned int, bool>> &faults, const unsigned* ids, unsigned n);
+    void schedule (unsigned wireID);
+
+    const circuit &c;
+    vector<uint64_t> good; // All ones or all zeros per wire.
+    vector<uint64_t> val; // Values of the 64 faulty machines (equal to good outside the cones of the group).
+    vector<uint64_t> force0, force1; // Bits of the faulty machines whose fault is on the wire (s-a-0 and s-a-1).
+    vector<unsigned> touched, sites;
+    vector<vector<unsigned>> levelQueue; // Gates scheduled for evaluation, bucketed by level.
+    vector<bool> queued;
+    unsigned low = 0, high = 0;
+};
+
+// PODEM with fault dropping. The workers take the faults in the order of the fault list, skipping the ones that are
+// already detected, and each test (X inputs set to 0, like in the report) is fault simulated as soon as PODEM returns
+// it against every fault that is still undetected and not being worked on. With one thread this is exactly the order
+// of the fault list, with more the tests come back in whatever order the workers finish them.
+// source[f] is the fault whose test detected f (f itself if PODEM generated the test, -1 if f was not detected); the
+// result of a dropped fault is DETECTED with that test. Its backtracks stay as they were: 0 if PODEM never targeted
+// it, or the backtracks PODEM spent before aborting it, which the PODEM effort in the report still counts.
+vector<podemResult> runPODEMDropping (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                                      unsigned numThreads, const podemOptions &options, const staticLearning *learned,
+                                      vector<int> &source);
+
+#endif
@@ -0,0 +1,184 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Static learning, dominators and the implication engine (see learn.h).
+*/
+
+#include <algorithm>
+#include <chrono>
+#include "learn.h"
+
+static bool cValue (eGate t) { return (t == OR) || (t == NOR); } // Controlling value of AND/NAND/OR/NOR.
+static bool invParity (eGate t) { return (t == NAND) || (t == NOR) || (t == INV); }
+
+implicationEngine::implicationEngine (const circuit &cRef, const staticLearning *l) : c(cRef), learned(l) {
+    val.assign(c.numWires(), -1);
+}
+
+void implicationEngine::reset() {
+    for (auto w: assignedWires) val[w] = -1;
+    assignedWires.clear();
+    qhead = 0;
+}
+
+bool implicationEngine::set (unsigned wireID, bool value) {
+    if (val[wireID] >= 0) return val[wireID] == value;
+    if (learned && learned->constant(wireID) == !value) return false;
+    val[wireID] = value;
+    assignedWires.push_back(wireID);
+    return true;
+}
+
+// Implies the output of g from its inputs, or its inputs from its output. Returns false on a conflict.
+bool implicationEngine::checkGate (unsigned g) {
+    const unsigned* in = c.fanin(g);
+    unsigned n = c.numFanin(g);
+    unsigned o = c.outWire[g];
+    bool inv = invParity(c.type[g]);
+
+    if (c.type[g] == INV || c.type[g] == BUF) {
+        if (val[in[0]] >= 0) return set(o, val[in[0]] ^ inv);
+        if (val[o] >= 0) return set(in[0], val[o] ^ inv);
+        return true;
+    }
+
+    bool cv = cValue(c.type[g]);
+    unsigned xCount = 0, xInput = 0;
+    for (unsigned i = 0; i < n; i++) {
+        if (val[in[i]] == cv) return set(o, cv ^ inv); // One controlling input sets the output.
+        if (val[in[i]] < 0) {
+            xCount++;
+            xInput = in[i];
+        }
+    }
+    if (!xCount) return set(o, !cv ^ inv);
+    if (val[o] < 0) return true;
+
+    // Output not controlled: every input is non-controlling. Output controlled and one X input left: that input is it.
+    if (val[o] == (!cv ^ inv)) {
+        for (unsigned i = 0; i < n; i++) {
+            if (!set(in[i], !cv)) return false;
+        }
+    }
+    else if (xCount == 1) return set(xInput, cv);
+    return true;
+}
+
+bool implicationEngine::assign (unsigned wireID, bool value) {
+    if (!set(wireID, value)) return false;
+    while (qhead < assignedWires.size()) {
+        if (limit && assignedWires.size() >= limit) return true; // Incomplete, but what was implied holds.
+        unsigned x = assignedWires[qhead++];
+
+        if (learned) {
+            unsigned l = 2 * x + val[x];
+            for (unsigned i = 0, n = learned->numImplied(l); i < n; i++) {
+                unsigned imp = learned->implied(l)[i];
+                if (!set(imp >> 1, imp & 1)) return false;
+            }
+        }
+        unsigned d = c.driverOf(x);
+        if (d != NO_GATE && !checkGate(d)) return false;
+        const unsigned* fo = c.fanout(x);
+        for (unsigned i = 0; i < c.numFanout(x); i++) {
+            if (!checkGate(fo[i])) return false;
+        }
+    }
+    return true;
+}
+
+void staticLearning::clear() {
+    implStart.clear();
+    implLit.clear();
+    constValue.clear();
+    idomWire.clear();
+    numConstants = 0;
+    buildSeconds = 0.0;
+    isBuilt = false;
+}
+
+void staticLearning::build (const circuit &c, unsigned maxImplied) {
+    auto start = chrono::steady_clock::now();
+    clear();
+    constValue.assign(c.numWires(), -1);
+
+    // Learning uses direct implication only, plus the constants found so far.
+    implicationEngine engine(c, this);
+    engine.limit = maxImplied;
+    vector<pair<unsigned, unsigned>> learnt; // (literal, implied literal)
+    for (unsigned w = 0; w < c.numWires(); w++) {
+        if (!c.hasWire(w)) continue;
+        for (int v = 0; v < 2; v++) {
+            if (constValue[w] >= 0) break;
+            engine.reset();
+            if (!engine.assign(w, v)) { // w=v is impossible.
+                constValue[w] = !v;
+                numConstants++;
+                break;
+            }
+            for (auto x: engine.assigned()) {
+                unsigned g = c.driverOf(x);
+                if (x == w || g == NO_GATE || c.type[g] == INV || c.type[g] == BUF) continue;
+                bool u = engine.value(x);
+                bool controlled = cValue(c.type[g]) ^ invParity(c.type[g]); // Output of a gate with a controlling input.
+                if (u != controlled) learnt.push_back(make_pair(2 * x + !u, 2 * w + !v));
+            }
+        }
+    }
+    engine.reset();
+
+    // Compressed table of the learned implications, sorted and without repeats.
+    sort(learnt.begin(), learnt.end());
+    learnt.erase(unique(learnt.begin(), learnt.end()), learnt.end());
+    implStart.assign(2 * c.numWires() + 1, 0);
+    for (auto &l: learnt) implStart[l.first + 1]++;
+    for (unsigned l = 0; l < 2 * c.numWires(); l++) implStart[l + 1] += implStart[l];
+    implLit.reserve(learnt.size());
+    for (auto &l: learnt) implLit.push_back(l.second);
+
+    dominators(c);
+    chrono::duration<double> used = chrono::steady_clock::now() - start;
+    buildSeconds = used.count();
+    isBuilt = true;
+}
+
+/*
+ * Immediate dominators toward the primary outputs. The outputs all lead to a virtual sink, so the immediate dominator
+ * of a wire is the nearest common dominator of the output wires of its fanout gates (and of the sink if it is an
+ * output itself). Wires are visited from the highest level down, so those are always known already.
+ */
+void staticLearning::dominators (const circuit &c) {
+    unsigned sink = c.numWires();
+    vector<unsigned> idom(c.numWires() + 1, DOM_NONE), depth(c.numWires() + 1, 0);
+    idom[sink] = sink;
+
+    auto meet = [&](unsigned a, unsigned b) {
+        while (a != b) {
+            if (depth[a] >= depth[b]) a = idom[a];
+            else b = idom[b];
+        }
+        return a;
+    };
+    auto visit = [&](unsigned w) {
+        unsigned d = c.isPO(w) ? sink : DOM_NONE;
+        const unsigned* fo = c.fanout(w);
+        for (unsigned i = 0; i < c.numFanout(w) && d != sink; i++) {
+            unsigned o = c.outWire[fo[i]];
+            if (idom[o] == DOM_NONE) continue; // o is not observable.
+            d = (d == DOM_NONE) ? o : meet(d, o);
+        }
+        idom[w] = d;
+        if (d != DOM_NONE) depth[w] = depth[d] + 1;
+    };
+
+    for (unsigned i = c.numGates(); i-- > 0;) visit(c.outWire[c.order[i]]);
+    for (unsigned w = 0; w < c.numWires(); w++) {
+        if (c.driverOf(w) == NO_GATE) visit(w);
+    }
+
+    idomWire.assign(c.numWires(), DOM_NONE);
+    for (unsigned w = 0; w < c.numWires(); w++) idomWire[w] = (idom[w] == sink) ? DOM_OUTPUT : idom[w];
+}
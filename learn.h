@@ -0,0 +1,82 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Global implications of the good circuit that PODEM turns into mandatory assignments (see podem.h).
+ Static learning (as in SOCRATES): every value of every wire is implied forward and backward through the gates. If
+ a=v implies b=u and b=!u is the value that one controlling input of b's gate is enough for (so direct implication
+ cannot go back from it), the contrapositive b=!u => a=!v is learned; this is what finds the implications that only
+ hold through reconvergent fanout. A value that implies a conflict can never occur, so the wire is a constant.
+ Dominators: wire d dominates wire w if every path from w to a primary output goes through d. The gate that drives a
+ dominator of a fault site is on every propagation path, so its side inputs (the ones outside the fanout cone of the
+ fault) need their non-controlling value in every test (unique sensitization).
+ A literal is 2*wire+value.
+*/
+
+#ifndef LEARN_H
+#define LEARN_H
+
+#include <climits>
+#include <vector>
+#include "circuit.h"
+
+const unsigned DOM_OUTPUT = UINT_MAX - 1; // Immediate dominator of a wire that is only dominated by the outputs.
+const unsigned DOM_NONE = UINT_MAX; // Immediate dominator of a wire that no primary output can observe.
+
+class staticLearning {
+public:
+    // Learns the implications and computes the dominators of c. maxImplied bounds the wires implied from one value,
+    // which keeps the pass linear in the circuit size.
+    void build (const circuit &c, unsigned maxImplied = 256);
+    void clear();
+    bool built() const { return isBuilt; }
+
+    // Learned implications of literal l.
+    unsigned numImplied (unsigned l) const { return (l + 1 < implStart.size()) ? implStart[l+1] - implStart[l] : 0; }
+    const unsigned* implied (unsigned l) const { return implLit.data() + implStart[l]; }
+    int8_t constant (unsigned wireID) const { return (wireID < constValue.size()) ? constValue[wireID] : -1; }
+    unsigned idom (unsigned wireID) const { return (wireID < idomWire.size()) ? idomWire[wireID] : DOM_NONE; }
+
+    size_t implications() const { return implLit.size(); }
+    unsigned constants() const { return numConstants; }
+    double seconds() const { return buildSeconds; }
+
+private:
+    void dominators (const circuit &c);
+
+    vector<unsigned> implStart, implLit;
+    vector<int8_t> constValue;
+    vector<unsigned> idomWire;
+    unsigned numConstants = 0;
+    double buildSeconds = 0.0;
+    bool isBuilt = false;
+};
+
+// 3-valued implication in the good circuit: direct forward and backward implication through the gates, plus the
+// learned implications and constants when a staticLearning is given. Values stay until reset.
+class implicationEngine {
+public:
+    implicationEngine (const circuit &cRef, const staticLearning *l = nullptr);
+
+    void reset(); // Clears every value that was implied since the last reset.
+    // Sets wireID to value and implies what follows. Returns false on a conflict (the values are then incomplete).
+    bool assign (unsigned wireID, bool value);
+    int8_t value (unsigned wireID) const { return val[wireID]; }
+    const vector<unsigned> &assigned() const { return assignedWires; } // In the order they were implied.
+
+    unsigned limit = 0; // Implication stops after this many values (0 means no limit).
+
+private:
+    bool set (unsigned wireID, bool value);
+    bool checkGate (unsigned g);
+
+    const circuit &c;
+    const staticLearning *learned;
+    vector<int8_t> val;
+    vector<unsigned> assignedWires;
+    size_t qhead = 0; // assignedWires[qhead..] still have to be implied from.
+};
+
+#endif
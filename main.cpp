@@ -1,63 +1,196 @@
 /*
  Author: Chibudem [Christian] Offodile
- Date last modified: 11/04/2023
+ Date last modified: 10/16/2026
  Class: ECE 6140-A
 
  Description:
- This is a program that takes in the description of a logic circuit from a txt file and can simulate the circuit with a
- set of inputs (test vectors). There are four txt files included in this project directory where the logic circuits will
- be pulled from. Each circuit will be simulated with 5 test vectors that are predetermined for each circuit.
- The program is also a deductive fault simulator which, if given a test vector, can output all the faults (bar input
- node faults) that the test vector detects.
+ This is a program that takes in the description of a logic circuit from a txt file (or an ISCAS .bench file, see
+ netlist.h) and can simulate the circuit with a set of inputs (test vectors). It is also a fault simulator which, if
+ given a test vector, can output all the faults that the test vector detects, and, if given no vectors in mode 'b', a
+ test generator that runs PODEM (with fault dropping, a SAT fallback for the faults it aborts and test compaction) on
+ the faults of the fault file. The program runs in one of four ways:
+ - Interactive: the circuit file, the mode ('a' for all the faults, 'b' for the fault file) and the moment the vector
+   file is ready are asked for on the console.
+ - Batch: --circuit FILE and --mode a|b answer the prompts, with --faults, --vectors and --output naming the other
+   files, so nothing is read from the console.
+ - Conversion: --convert FILE writes the text form of a binary pattern file (--patterns FILE, see patfile.h) to the
+   --output file.
+ - Server: --serve reads requests from stdin and --socket PATH from a Unix domain socket, on a circuit that stays
+   loaded between requests (see server.h).
+ The other options tune the engines: --threads, --backtracks, --time-limit, --no-scoap, --no-xpath, --no-learning,
+ --no-sat, --sat-conflicts, --no-compact, --no-dynamic-compaction, --random-phase, --seed, --random-window, --ppsfp,
+ --simd, --no-image, --async-output and --trace (each is described where its global is declared below).
 */
 
 #include <iostream>
 #include <sstream>
 #include <fstream>
-#include <random>
-#include <cmath>
 #include <set>
+#include <thread>
 #include "Classes.h"
 #include "podem.h"
+#include "circuit.h"
+#include "psim.h"
+#include "ppsfp.h"
+#include "faults.h"
+#include "cktimage.h"
+#include "compact.h"
+#include "randpat.h"
+#include "tape.h"
+#include "simd.h"
+#include "deductive.h"
+#include "server.h"
+#include "faultsim.h"
+#include "satatpg.h"
+#include "learn.h"
+#include "fpsim.h"
+#include "output.h"
+#include "patfile.h"
 
 using namespace std;
 
 // FUNCTION DECLARATIONS
 void simCircuit (const string& txt, vector<vector<bool>> &testV);
+void ppsfpSimCircuit (const string& txt, vector<vector<bool>> &testV);
 void fileRead (const string& file);
-void applyInput (vector<vector<bool>> &cktIn, int n);
-void broadCast (unsigned int wireID, bool outBit, const list<fault> &fList);
+const vector<unsigned> &applyInput (vector<vector<bool>> &cktIn, int n);
 bool targetFaultRead (const string& txt);
 vector<bool> randomVector (unsigned int numBits);
-void printVector (vector<bool> inVector);
-void callPODEM (string& cktFile);
+void printVector (const vector<bool> &inVector);
+void printOutput (const vector<bool> &outVector);
+unsigned checkOutputs (const vector<bool> &outVector);
+void callPODEM();
+void writePatterns (const vector<podemResult> &results, const vector<int> &droppedBy,
+                    const vector<vector<bool>> &compacted);
 void readVector();
 
 // GLOBAL VARIABLES
-list<gate> youngGates; // Gates that are just created (so not ready) are added here.
-list<gate> readyGates; // Gates with all inputs ready are added here to be simulated.
-vector<gate> outGates; // Output wire values to print at the end of the simulation.
 vector<unsigned int> inWires; // inWires[i] needs to correspond to cktInput1[j][i] for ease of setting inputs.
 bool simFlag; // If the user inputs 'a' then simFlag is true, else it's false.
 bool pFlag; // If pFlag == true, PODEM will be run
+bool ppsfpFlag = false; // If the program is started with --ppsfp, the PPSFP fault simulator replaces the deductive one.
+bool imageFlag = true; // Load the circuit through its binary image (<file>.cimg), turned off with --no-image.
+unsigned numThreads = thread::hardware_concurrency(); // Threads used by PODEM and fault simulation, set with --threads N.
+podemOptions pOptions; // Per fault PODEM effort (--backtracks N, --time-limit SECONDS), --no-scoap and --no-xpath.
+bool learnFlag = true; // Static learning and dominators for PODEM, turned off with --no-learning.
+bool satFlag = true; // Give the faults that PODEM aborts to the SAT engine, turned off with --no-sat.
+satOptions sOptions; // Conflict limit of the SAT engine per fault (--sat-conflicts N).
+bool compactFlag = true; // Compact the PODEM test set, turned off with --no-compact.
+compactOptions cOptions; // --no-dynamic-compaction keeps only the static compaction steps.
+bool randomFlag = false; // Run a random pattern phase before PODEM (--random-phase).
+randomPhaseOptions rOptions; // Seed (--seed N) and saturation window (--random-window N) of the random patterns.
+patternRng vecRng; // Source of the random test vectors, seeded with --seed.
+string traceFile; // Chrome trace of the PODEM run (--trace FILE, needs a build with -DPODEM_TRACE).
 vector<pair<unsigned int, bool>> bFaults; // When the user enters b, these are the wires who's faults will be deductively simmed.
 set<pair<unsigned int, bool>> setFaults; // takes the detected faults, deleted duplicates and arranges them in ascending order.
-fstream wStream;
+compiledCircuit cktTape; // ckt compiled to an instruction tape by fileRead, used for the good machine outputs.
+deductiveSim dSim(ckt); // Deductive fault simulator, given its faults by fileRead.
+vector<int8_t> poValues; // Value of every primary output wire in the last applyInput (-1 for the other wires).
+string faultFile = "infault.txt"; // Fault input file of 'b' (--faults FILE).
+string vectorFile = "userVector.txt"; // Test vector file (--vectors FILE).
+string outputFile = "outputfile.txt"; // Report file (--output FILE).
+string patternFile; // Binary pattern and fault status file of PODEM (--patterns FILE), see patfile.h.
+bool asyncFlag = false; // Write the report and pattern files from a background thread (--async-output).
+reportStream wStream;
 vector<vector<bool>> cktInput; // Circuit input vector for PODEM
 
-int main() {
-    string uIN, uIN2, cktName;
+#ifndef PODEM_NO_MAIN // The benchmark (bench.cpp) has its own main and uses the functions below.
+int main(int argc, char* argv[]) {
+    string uIN, uIN2, cktName, socketPath, convertFile;
+    bool serveFlag = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--ppsfp") ppsfpFlag = true;
+        else if (arg == "--threads" && i + 1 < argc) numThreads = stoul(argv[++i]);
+        else if (arg == "--backtracks" && i + 1 < argc) pOptions.backtracks = stoul(argv[++i]);
+        else if (arg == "--time-limit" && i + 1 < argc) pOptions.seconds = stod(argv[++i]);
+        else if (arg == "--no-scoap") pOptions.scoap = false;
+        else if (arg == "--no-xpath") pOptions.xPath = false;
+        else if (arg == "--no-image") imageFlag = false;
+        else if (arg == "--no-compact") compactFlag = false;
+        else if (arg == "--no-learning") learnFlag = false;
+        else if (arg == "--no-sat") satFlag = false;
+        else if (arg == "--sat-conflicts" && i + 1 < argc) sOptions.conflicts = stoull(argv[++i]);
+        else if (arg == "--no-dynamic-compaction") cOptions.dynamic = false;
+        else if (arg == "--random-phase") randomFlag = true;
+        else if (arg == "--seed" && i + 1 < argc) {
+            rOptions.seed = stoull(argv[++i]);
+            vecRng.reseed(rOptions.seed);
+        }
+        else if (arg == "--random-window" && i + 1 < argc) rOptions.window = stoul(argv[++i]);
+        else if (arg == "--simd" && i + 1 < argc) setSimdWidth(stoul(argv[++i]));
+        else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+#ifndef PODEM_TRACE
+            cout << "Tracing is not compiled in (build with -DPODEM_TRACE), --trace was ignored." << endl;
+#endif
+        }
+        // Batch mode: the answers to the prompts and the file names are given on the command line.
+        else if (arg == "--circuit" && i + 1 < argc) cktName = argv[++i];
+        else if (arg == "--mode" && i + 1 < argc) uIN = argv[++i];
+        else if (arg == "--faults" && i + 1 < argc) faultFile = argv[++i];
+        else if (arg == "--vectors" && i + 1 < argc) vectorFile = argv[++i];
+        else if (arg == "--output" && i + 1 < argc) outputFile = argv[++i];
+        else if (arg == "--patterns" && i + 1 < argc) patternFile = argv[++i];
+        else if (arg == "--async-output") asyncFlag = true;
+        // Conversion: --convert FILE writes the text form of a pattern file to the --output file and exits.
+        else if (arg == "--convert" && i + 1 < argc) convertFile = argv[++i];
+        // Server mode: requests on stdin (--serve) or on a Unix domain socket (--socket PATH), see server.h.
+        else if (arg == "--serve") serveFlag = true;
+        else if (arg == "--socket" && i + 1 < argc) socketPath = argv[++i];
+        else cout << "Unknown option " << arg << " was ignored." << endl;
+    }
+
+    if (!convertFile.empty()) {
+        patternSet pSet;
+        string error;
+        if (!readPatternFile(convertFile, pSet, error)) {
+            cout << error << endl;
+            return 0;
+        }
+        if (!wStream.open(outputFile, asyncFlag)) {
+            cout << "The stream did not open." << endl;
+            return 0;
+        }
+        writePatternText(wStream, pSet);
+        if (!wStream.close()) cout << "Could not write " << outputFile << endl;
+        return 0;
+    }
+
+    if (serveFlag || !socketPath.empty()) {
+        serverOptions srvOptions;
+        srvOptions.podem = pOptions;
+        srvOptions.compact = cOptions;
+        srvOptions.compactFlag = compactFlag;
+        srvOptions.learning = learnFlag;
+        srvOptions.satFlag = satFlag;
+        srvOptions.sat = sOptions;
+        srvOptions.threads = max(1u, numThreads);
+        srvOptions.useImage = imageFlag;
+        atpgServer server(srvOptions);
+        if (!cktName.empty() && !server.load(cktName)) cout << "The circuit " << cktName << " could not be loaded." << endl;
+        if (socketPath.empty()) server.serve(cin, cout);
+        else if (!server.serveSocket(socketPath)) cout << "Could not listen on the socket " << socketPath << endl;
+        return 0;
+    }
 
-    cout << "Please enter the name of the file containing the circuit that will be simulated." << endl;
-    getline (cin, cktName);
+    bool batch = !cktName.empty() && !uIN.empty(); // Nothing has to be read from the user.
+    if (cktName.empty()) {
+        cout << "Please enter the name of the file containing the circuit that will be simulated." << endl;
+        getline (cin, cktName);
+    }
 
-    cout << "Enter 'a' to automatically simulate all the nets in the circuit, ";
-    cout << "or enter 'b' to simulate only the faults included in the fault input file (infault.txt)." << endl;
-    getline (cin, uIN);
+    if (uIN.empty()) {
+        cout << "Enter 'a' to automatically simulate all the nets in the circuit, ";
+        cout << "or enter 'b' to simulate only the faults included in the fault input file (" << faultFile << ")." << endl;
+        getline (cin, uIN);
+    }
 
     while (true) {
         if (uIN[0] == 'a' && uIN.size() == 1) {
             simFlag = true;
+            if (batch) break;
             cout << "Enter the test vectors you'd like to use in the userVector.txt file. Enter any character when you're "
                     "done. If the file is empty, random test vectors will be generated and used to simulate all the "
                     "faults in the circuit. " << endl;
@@ -66,7 +199,8 @@ int main() {
         }
         else if (uIN[0] == 'b' && uIN.size() == 1) {
             simFlag = false;
-            if (!targetFaultRead("infault.txt")) return 0;
+            if (!targetFaultRead(faultFile)) return 0;
+            if (batch) break;
 
             cout << "Enter the test vectors you'd like to use in the userVector.txt file. Enter any character when you're "
                     "done. If the file is empty, PODEM will be used to generate test vectors for each fault in the "
@@ -77,21 +211,23 @@ int main() {
         }
         else {
             cout << "Invalid input, please choose a or b" << endl;
+            if (batch) return 0;
             getline (cin, uIN);
         }
     }
 
-    wStream.open("outputfile.txt", ios::out);
+    wStream.open(outputFile, asyncFlag);
 
     fileRead(cktName);
-    cin >> uIN2; // Waits for user to finish entering input vectors beforing reading them.
+    if (!batch) cin >> uIN2; // Waits for user to finish entering input vectors beforing reading them.
     readVector();
-    if (pFlag) callPODEM(cktName);
+    if (pFlag) callPODEM();
     else simCircuit(cktName, cktInput);
 
-    wStream.close();
+    if (!wStream.close()) cout << "Could not write the report " << outputFile << endl;
     return 0;
 }
+#endif
 
 // FUNCTION DEFINITIONS
 
@@ -150,21 +286,26 @@ bool targetFaultRead (const string& txt) {
 }
 
 void simCircuit (const string& txt, vector<vector<bool>>& testV) {
+    if (ppsfpFlag) {
+        ppsfpSimCircuit(txt, testV);
+        return;
+    }
+
     wStream << "CIRCUIT " << txt << " OUTPUTS:\n";
     if (!testV.empty()) { // Loop to apply each test vector for a given ckt (txt) if we're given a test vectors.
+        vector<vector<bool>> outV = simVectorsWide(cktTape, testV); // Primary output values, up to 512 vectors per tape pass.
+        unsigned mismatches = 0;
         for (int i = 0; i < testV.size(); i++) {
-            if (i > 0 && simFlag) {
-                for (auto &yGate : youngGates) yGate.setFaultSim(yGate.getOutputID());
-            }
-
-            applyInput(testV, i);
+            // Random vectors are not being used so the # of faults detected is counted for each individual vector.
+            const vector<unsigned> &detected = applyInput(testV, i);
+            mismatches += checkOutputs(outV[i]);
             printVector(testV[i]);
-            wStream << "\nFAULTS DETECTED:" << endl;
-            for (auto &j: setFaults) wStream << j.first << " stuck at " << j.second << endl;
-            wStream << setFaults.size() << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n" << endl;
-            setFaults.clear(); // Random vectors are not being used so the # of faults detected is counted for each individual vector.
-            for (auto &yGate : youngGates) yGate.invalidateGate(); // Reset all gates [wires and faultlists] for the next test vector.
+            printOutput(outV[i]);
+            wStream << "\nFAULTS DETECTED:\n";
+            for (auto f: detected) wStream << dSim.faults()[f].first << " stuck at " << dSim.faults()[f].second << "\n";
+            wStream << detected.size() << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n\n";
         }
+        if (mismatches) cout << "The compiled simulation disagrees with applyInput on " << mismatches << " outputs!" << endl;
     }
 
     else { // If we are not given any test vectors, randomly generate vectors to simulate the circuit. Only stop simulating once 90% fault coverage has been reached or exceeded.
@@ -174,23 +315,19 @@ void simCircuit (const string& txt, vector<vector<bool>>& testV) {
         }
 
         int n = 0;
-        float fCoverage = 0.0, fDet;
+        float fCoverage = 0.0, fDet = 0;
         unsigned numIn = inWires.size();
         vector<vector<bool>> rTestV;
-        unsigned numFaults = (youngGates.size() * 2) + (numIn * 2); // Only output wires and primary inputs are considered for fault detection.
+        unsigned numFaults = (ckt.numGates() * 2) + (numIn * 2); // Only output wires and primary inputs are considered for fault detection.
         cout << "\nCIRCUIT " << txt << " OUTPUTS:\n";
         
+        dSim.clearDropped();
         while (fCoverage <= 0.95) {
-            if (n > 0) {
-                for (auto &yGate : youngGates) yGate.setFaultSim(yGate.getOutputID());
-            }
-
             rTestV.push_back(randomVector(numIn));
-            applyInput(rTestV, n);
-            fDet = setFaults.size(); // # faults detected
+            fDet += applyInput(rTestV, n).size(); // # faults detected, a detected fault is dropped for the next vectors.
+            dSim.dropDetected();
             fCoverage = fDet/numFaults;
             cout << n+1 << " tests resulted in " << fCoverage*100.0 << "% fault coverage." << endl;
-            for (auto &yGate : youngGates) yGate.invalidateGate(); // Reset all gates [wires and faultlists] for the next test vector.
 
             n++;
             if (n > 9999) {
@@ -199,298 +336,386 @@ void simCircuit (const string& txt, vector<vector<bool>>& testV) {
             }
         }
 
-        // After applying all the vectors, print all the faults that were detected.
+        // After applying all the vectors, print the vectors with their outputs and all the faults that were detected.
         wStream << "*** RANDOM TEST VECTORS WERE USED ***\n";
-        wStream << "\nFAULTS DETECTED:" << endl;
-        for (auto &j: setFaults) wStream << j.first << " stuck at " << j.second << endl;
-        wStream << setFaults.size() << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n" << endl;
-        setFaults.clear();
-    }
-}
-
-// Generate a random number from 0 to [2^numBits - 1], then converts it to binary.
-vector<bool> randomVector (unsigned int numBits) {
-    int max = pow(2, numBits) - 1;
-    vector<bool> randTest;
-
-    random_device r;
-    default_random_engine generator(r());
-    uniform_int_distribution<int> distribution(0,max);
-    int randNum = distribution(generator);  // generates random number in the range 0 to max.
-    cout << "\nThe random number is " << randNum << endl;
-    // Convert randNum to binary and store in randTest.
-    while (randNum > 0) {
-        randTest.push_back(randNum % 2); // The endianness is backwards but it doesn't affect randomness, and its faster.
-        randNum /= 2;
-    }
-
-    // For small numbers, randTest will have a bit count that is less than the number of inputs of the ckt, so add lagging zeros (weird endianness).
-    // Vector<bool> packs the bools as bits in memory which causes SEG Faults to not show up. However this cleanup is still needed to prevent unpredictable behavior.
-    numBits -= randTest.size();
-    while (numBits > 0) { // Can use resize 1 time instead (if its faster).
-        randTest.push_back(0);
-        numBits--;
+        vector<vector<bool>> outV = simVectorsWide(cktTape, rTestV);
+        for (unsigned i = 0; i < rTestV.size(); i++) {
+            printVector(rTestV[i]);
+            printOutput(outV[i]);
+        }
+        wStream << "\nFAULTS DETECTED:\n";
+        for (unsigned f = 0; f < dSim.faults().size(); f++) {
+            if (dSim.dropped(f)) wStream << dSim.faults()[f].first << " stuck at " << dSim.faults()[f].second << "\n";
+        }
+        wStream << fDet << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n\n";
+        dSim.clearDropped();
     }
-    return randTest;
 }
 
-void fileRead (const string &file) {
-    fstream stream;
-    stream.open(file, ios::in);
-
-    if (stream.is_open()) {
-        int exNum; // How many wires (numbers) to expect after a specific gate.
-        unsigned int tempID;
-        vector<unsigned int> wireIDs; // To keep track of wire IDs till the gate they belong to is created.
-        eGate track;
-
-        // Read data from the file object and put it into a string.
-        string input;
-        while (getline(stream, input)) {
-            istringstream inStream(input);
-
-            while (getline(inStream, input, ' ')) {
-                if (input == "INV") {
-                    track = INV; // I just got an inverter, I am still expecting the 2 wires that belong to it.
-                    exNum = 2;
-                }
-
-                else if (input == "NAND") {
-                    track = NAND;
-                    exNum = 3;
+// Same reports as simCircuit, but the faults are found with the PPSFP simulator (one fault at a time, on blocks of
+// vectors as wide as the SIMD kernel, spread over numThreads threads) instead of carrying deductive fault lists
+// through the gates.
+void ppsfpSimCircuit (const string& txt, vector<vector<bool>>& testV) {
+    wStream << "CIRCUIT " << txt << " OUTPUTS:\n";
+    faultSet fSet; // The 'a' mode fault universe and its collapsed target list.
+    if (simFlag) fSet.build(ckt);
+    vector<pair<unsigned int, bool>> targets = simFlag ? fSet.universe : bFaults;
+    parallelFaultSim fSim(ckt, cktTape, numThreads);
+    unsigned width = simdWidth(); // Vectors per block of the SIMD kernel (64, 256 or 512).
+    vector<uint64_t> piWords;
+
+    if (!testV.empty()) {
+        // A few blocks of vectors at a time, so the detection bitmap stays small.
+        vector<uint64_t> det;
+        vector<vector<bool>> outV = simVectorsWide(cktTape, testV);
+        for (unsigned first = 0; first < testV.size(); first += 4 * width) {
+            unsigned count = (testV.size() - first < 4 * width) ? testV.size() - first : 4 * width;
+            unsigned words = parallelFaultSim::wordsPer(count);
+            fSim.detectAll(targets, testV, first, count, det);
+
+            // Report every vector of the block on its own, like the deductive simulation does.
+            for (unsigned k = 0; k < count; k++) {
+                printVector(testV[first + k]);
+                printOutput(outV[first + k]);
+                for (unsigned f = 0; f < targets.size(); f++) {
+                    if ((det[f * words + k / 64] >> (k % 64)) & 1) setFaults.insert(targets[f]);
                 }
+                wStream << "\nFAULTS DETECTED:\n";
+                for (auto &j: setFaults) wStream << j.first << " stuck at " << j.second << "\n";
+                wStream << setFaults.size() << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n\n";
+                setFaults.clear();
+            }
+        }
+    }
 
-                else if (input == "NOR") {
-                    track = NOR;
-                    exNum = 3;
-                }
+    else {
+        if (!simFlag) { // If the user entered 'b' then a random vector generation test will be useless.
+            cout << "A random test generator simulation should not be run when target faults are input." << endl;
+            return;
+        }
 
-                else if (input == "AND") {
-                    track = AND;
-                    exNum = 3;
-                }
+        unsigned numIn = inWires.size();
+        unsigned numFaults = targets.size(); // Coverage is reported against the uncollapsed universe.
+        unsigned numTargets = fSet.targets.size();
+        unsigned fDet = 0; // # faults detected
+        unsigned lastNew = 0; // Number of vectors up to the last one that detected a new fault.
+        float fCoverage = 0.0;
+        bool done = false;
+        vector<vector<bool>> rTestV;
+        vector<int> targetFirst(numTargets, -1); // Index of the first random vector that detected each target fault.
+        vector<int> firstDet; // Same for every fault of the universe.
+        vector<unsigned> newDet(width), live;
+        vector<pair<unsigned int, bool>> liveFaults;
+        cout << "\nCIRCUIT " << txt << " OUTPUTS:\n";
+        cout << numFaults << " faults were collapsed to " << numTargets << " target faults." << endl;
+
+        while (!done) {
+            // Generate and simulate a whole block of random vectors, then walk through it one vector at a time so the
+            // simulation stops at the same point the one vector at a time simulation would have.
+            unsigned first = rTestV.size();
+            for (unsigned k = 0; k < width; k += BLOCK_SIZE) {
+                vecRng.fill(piWords, numIn);
+                unpackVectors(piWords, BLOCK_SIZE, rTestV);
+            }
+            vector<vector<bool>> block(rTestV.begin() + first, rTestV.end());
+
+            live.clear(); // Fault dropping: detected faults are not simulated again.
+            liveFaults.clear();
+            for (unsigned t = 0; t < numTargets; t++) {
+                if (targetFirst[t] >= 0) continue;
+                live.push_back(t);
+                liveFaults.push_back(targets[fSet.targets[t]]);
+            }
+            vector<int> blockFirst = fSim.firstDetection(liveFaults, block);
+            for (unsigned i = 0; i < live.size(); i++) {
+                if (blockFirst[i] >= 0) targetFirst[live[i]] = first + blockFirst[i];
+            }
 
-                else if (input == "OR") {
-                    track = OR;
-                    exNum = 3;
-                }
+            // Spread the detections to the collapsed faults and count the new detections of each vector of the block.
+            firstDet = fSet.expand(targetFirst);
+            newDet.assign(width, 0);
+            for (unsigned f = 0; f < numFaults; f++) {
+                if (firstDet[f] >= (int) first) newDet[firstDet[f] - first]++;
+            }
 
-                else if (input == "BUF") {
-                    track = BUF;
-                    exNum = 2;
-                }
+            for (unsigned k = 0; k < width; k++) {
+                fDet += newDet[k];
+                if (newDet[k]) lastNew = first+k+1;
+                fCoverage = (float) fDet/numFaults;
+                cout << first+k+1 << " tests resulted in " << fCoverage*100.0 << "% fault coverage." << endl;
 
-                else if (input == "INPUT") {
-                    track = INPUT;
+                if (fCoverage > 0.95) done = true;
+                else if (first+k+1 - lastNew >= rOptions.window) {
+                    cout << "\nThe fault coverage saturated, " << rOptions.window << " vectors did not detect a new fault." << endl;
+                    done = true;
                 }
-
-                else if (input == "OUTPUT") {
-                    track = OUTPUT;
+                else if (first+k+1 > 9999) {
+                    cout << "\nRandom test generation cannot produce sufficient coverage in a timely manner." << endl;
+                    done = true;
                 }
-
-                // input must be a number if all other cases failed.
-                // istringstream might create a garbage number which will be stored in tempID.
-                else {
-                    istringstream(input) >> tempID;
-                    if (track == INPUT) {
-                        if (input.empty()) continue;
-                        if (tempID != -1) inWires.push_back(tempID); // Still marking and setting input wires
-                    }
-
-                    else if (track == OUTPUT) {
-                        if (input.empty()) continue;
-                        if (tempID != -1) {
-                            list<gate>::iterator g;
-                            for (g = youngGates.begin(); g != youngGates.end(); g++) {
-                                if (g->getOutputID() == tempID) g->isOutGate = true;
-                            }
-                        }
-                    }
-
-                    else { // If track is != INPUT or OUTPUT then the number cannot be less than 1.
-                        if (tempID < 1) {
-                            cout << "Invalid value from the input file." << endl;
-                            return;
-                        }
-
-                        wireIDs.push_back(tempID); // Store the wire ID
-                        exNum--; // Decrement the number of expected wires for this specific gate (track).
-
-                        if (exNum == 0) { // All needed numbers have been received so create the gate.
-                            gate newGate(track, wireIDs); // Now that we have all the wires of the gate, create the gate.
-                            // If the user entered 'a', all output wires are simmed. Primary inputs will be set in broadCast.
-                            if (simFlag) {
-                                unsigned outWire;
-                                if (newGate.hasTwoIn) outWire = wireIDs[2];
-                                else outWire = wireIDs[1];
-                                newGate.setFaultSim(outWire);
-                            }
-                            wireIDs.clear(); // Clear the wire IDs once they have been created and attached to a gate.
-                            youngGates.push_back(newGate); // Add the new gate to the list of gates whose inputs aren't ready.
-                        }
-                    }
+                if (done) {
+                    rTestV.resize(first+k+1);
+                    break;
                 }
             }
         }
-        stream.close(); // Close the file object.
+
+        wStream << "*** RANDOM TEST VECTORS WERE USED ***\n";
+        vector<vector<bool>> outV = simVectorsWide(cktTape, rTestV);
+        for (unsigned i = 0; i < rTestV.size(); i++) {
+            printVector(rTestV[i]);
+            printOutput(outV[i]);
+        }
+        for (unsigned f = 0; f < numFaults; f++) {
+            if (firstDet[f] >= 0 && firstDet[f] < (int) rTestV.size()) setFaults.insert(targets[f]);
+        }
+        wStream << "\nFAULTS DETECTED:\n";
+        for (auto &j: setFaults) wStream << j.first << " stuck at " << j.second << "\n";
+        wStream << setFaults.size() << " FAULTS WERE DETECTED BY THE APPLIED VECTORS.\n\n";
+        setFaults.clear();
     }
-    else {
-        cout << "The stream did not open." << endl;
-        return;
+}
+
+// Random test vector of numBits bits, taken 64 bits at a time from the seeded generator.
+vector<bool> randomVector (unsigned int numBits) {
+    vector<bool> randTest(numBits);
+    uint64_t word = 0;
+    for (unsigned i = 0; i < numBits; i++) {
+        if (i % 64 == 0) word = vecRng.next();
+        randTest[i] = (word >> (i % 64)) & 1;
     }
+    return randTest;
 }
 
-// Takes in a reference to the array of input vectors and the index of the current input vector to be accessed.
-void applyInput (vector<vector<bool>> &cktIn, int n) {
-    // assign all the input wires their appropriate value and then spread those input values to any fanout nodes.
-    list<fault> empty; // The initial input values do not come with a propagated list so the fault list parameter of broadcast is empty.
-    for (unsigned i = 0; i < inWires.size(); i++) broadCast(inWires[i], cktIn[n][i], empty);
-
-    while (!readyGates.empty()) {
-        gate g = readyGates.front();
-        bool oBit = g.simOutput();
-        broadCast(g.getOutputID(), oBit, g.getFaultList()); // Sims the output of a gate, computes the fault list and THEN retrieves it.
-        if (g.isOutGate) {
-            if (!simFlag) { // Some primary output gates might have no fanout and therefore their local fault will never be propagated if the user entered 'b'. Their fault must be created directly.
-                for (auto bF: bFaults) {
-                    if ((bF.first == g.getOutputID()) && (bF.second != oBit)) {
-                        fault f(bF.second, bF.first);
-                        list<fault> gFL = g.getFaultList();
-                        gFL.push_back(f);
-                        g.setFaultList(bF.first, gFL);
-                        break; // Every wire only has one local fault so break once it is found and added.
-                    }
-                }
+void fileRead (const string &file) {
+    if (!loadCircuit(file, ckt, imageFlag)) return; // readCircuit prints what went wrong.
+    inWires = ckt.PIs;
+    cktTape.compile(ckt);
+
+    if (ppsfpFlag) return; // Only the deductive simulator needs its fault lists.
+
+    // 'a' simulates the whole fault universe with one class ID per equivalence class, 'b' only the faults of the
+    // fault file.
+    if (simFlag) {
+        faultSet fSet;
+        fSet.build(ckt);
+        vector<unsigned> classOf(fSet.universe.size()), classRep, classID(fSet.universe.size(), UINT_MAX);
+        for (unsigned f = 0; f < fSet.universe.size(); f++) {
+            unsigned r = fSet.rep[f];
+            if (classID[r] == UINT_MAX) {
+                classID[r] = classRep.size();
+                classRep.push_back(r);
             }
-            outGates.push_back(g);
+            classOf[f] = classID[r];
         }
-        readyGates.erase(readyGates.begin());
+        dSim.setFaults(fSet.universe, classOf, classRep);
     }
-
-    pair<unsigned int, bool> pFault;
-    for (auto &oG: outGates) {
-        // Use a set to sort the faults (after storing the faults as pairs) then print the sorted set of faults.
-        for (auto &f : oG.getFaultList()) {
-            pFault.first = f.getFaultWire();
-            pFault.second = f.getFault();
-            setFaults.insert(pFault);
-        }
+    else {
+        set<pair<unsigned int, bool>> sorted(bFaults.begin(), bFaults.end());
+        dSim.setFaults(vector<pair<unsigned int, bool>>(sorted.begin(), sorted.end()));
     }
-    outGates.clear();
 }
 
-// The broadCast function updates fanout nodes of wires whose logic values and lists have been computed. It finds all
-// the fanout input nodes for a given output wire that has been computed.
-void broadCast (unsigned int wireID, bool outBit, const list<fault> &fList) {
-    for (auto g = youngGates.begin(); g != youngGates.end(); g++) {
-        if (g->getInputID(1) == wireID) {
-            if (!simFlag) { // The user entered 'b'.
-                for (auto j: bFaults) {
-                    if ((j.first == wireID) && (j.second != outBit)) g->setFaultSim(wireID);
-                }
-                if (!fList.empty()) g->setFaultList(wireID, fList); // Propagate the fault list of the "origin node" that broadCast was called with.
-            }
-            // fList is only empty when broadcast is called for primary input wires. The initial fault of primary input wires needs to be created.
-            // If the user entered 'a', all primary input faults should be simmed.
-            else if (fList.empty()) g->setFaultSim(wireID);
-            else g->setFaultList(wireID, fList); // Propagate the fault list of the "origin node" that broadCast was called with.
-
-            g->setInput(outBit, wireID);
-            if (g->ready) { // Move g to the ready list and delete it from the young list if all of g's inputs are set.
-                readyGates.push_back(*g);
-                continue; // No need to check the second input since the gate was ready.
-            }
-        }
+// Takes in a reference to the array of input vectors and the index of the current input vector to be accessed.
+// Returns the faults (indices into dSim.faults()) that the vector detects.
+const vector<unsigned> &applyInput (vector<vector<bool>> &cktIn, int n) {
+    const vector<unsigned> &detected = dSim.simulate(cktIn[n]);
+    poValues.assign(ckt.numWires(), -1);
+    for (auto w: ckt.POs) poValues[w] = dSim.values()[w];
+    return detected;
+}
 
-        if (g->hasTwoIn) {
-            if (g->getInputID(2) == wireID) {
-                if (!simFlag) {
-                    for (auto j: bFaults) {
-                        if ((j.first == wireID) && (j.second != outBit)) g->setFaultSim(wireID);
-                    }
-                    if (!fList.empty()) g->setFaultList(wireID, fList);
-                }
-                else if (fList.empty()) g->setFaultSim(wireID);
-                else g->setFaultList(wireID, fList);
+// The vectors are formatted into a string first, so they go to the stream in one write instead of one per bit.
+void printVector (const vector<bool> &inVector) {
+    string s(inVector.size(), '0');
+    for (unsigned i = 0; i < inVector.size(); i++) s[i] += inVector[i];
+    wStream << "INPUT VECTOR " << s << " WAS USED\n";
+}
 
-                g->setInput(outBit, wireID);
-                if (g->ready) {
-                    readyGates.push_back(*g);
-                }
-            }
-        }
-    }
+void printOutput (const vector<bool> &outVector) {
+    string s(outVector.size(), '0');
+    for (unsigned i = 0; i < outVector.size(); i++) s[i] += outVector[i];
+    wStream << "OUTPUT VECTOR " << s << " WAS PRODUCED\n";
 }
 
-void printVector (vector<bool> inVector) {
-    wStream << "INPUT VECTOR ";
-    for (auto inV: inVector) wStream << inV;
-    wStream << " WAS USED\n";
+// Compares the primary outputs of the compiled simulation with the values applyInput computed for the same vector.
+// Returns the number of outputs that differ.
+unsigned checkOutputs (const vector<bool> &outVector) {
+    unsigned bad = 0;
+    for (unsigned o = 0; o < ckt.POs.size(); o++) {
+        int8_t v = poValues[ckt.POs[o]];
+        if ((v >= 0) && (v != outVector[o])) bad++;
+    }
+    return bad;
 }
 
-void callPODEM (string& cktFile) {
-    vector<bool> podemVector;
+void callPODEM() {
     for (auto bF: bFaults) {
         // Check if fault wire number makes sense
-        bool isValid = false;
-        for (auto yg: youngGates) {
-            if ((yg.getInputID(1) == bF.first) || (yg.getOutputID() == bF.first)) {
-                isValid = true;
-                break;
-            }
-            if (yg.hasTwoIn && (yg.getInputID(2) == bF.first)) {
-                isValid = true;
-                break;
-            }
-        }
-
-        if (!isValid) {
+        if (!ckt.hasWire(bF.first)) {
             cout << "Invalid wire number for the given circuit." << endl;
             return;
         }
+    }
 
-        fault userFault(bF.second, bF.first);
-
-        list<pair<unsigned, int8_t>>* testMatrix = PODEM(&youngGates, &inWires, &userFault);
-        if (testMatrix) { // If a vector was returned print it
-            wStream << "\nPRINTING TEST VECTOR RETURNED BY PODEM FOR THE FAULT " << bF.first;
-            wStream << " s-a-" << bF.second << ":" << endl;
-            for (auto tM = testMatrix->begin(); tM != testMatrix->end(); tM++) {
-                // cout << "Wire ID: " << tM->first << " Value: ";
-                if (tM->second == -1) {
-                    wStream << "X";
-                    podemVector.push_back(0);
-                }
-                else if (tM->second) {
-                    wStream << 1;
-                    podemVector.push_back(1);
-                }
-                else {
-                    wStream << 0;
-                    podemVector.push_back(0);
-                }
-            }
+    // With --random-phase, random patterns are fault simulated first and PODEM only gets the faults they missed.
+    randomPhaseResult random;
+    random.detectedBy.assign(bFaults.size(), -1);
+    if (randomFlag) random = randomPhase(ckt, bFaults, rOptions);
+    vector<pair<unsigned int, bool>> podemFaults;
+    for (unsigned f = 0; f < bFaults.size(); f++) {
+        if (random.detectedBy[f] < 0) podemFaults.push_back(bFaults[f]);
+    }
 
-            wStream << endl;
+    // The global implications are learned once for all the faults (the time is part of the report).
+    staticLearning learned;
+    if (learnFlag) {
+        learned.build(ckt);
+        wStream << "STATIC LEARNING FOUND " << learned.implications() << " IMPLICATIONS AND " << learned.constants();
+        wStream << " CONSTANT WIRES IN " << learned.seconds() << " SECONDS.\n";
+        cout << "Static learning: " << learned.implications() << " implications, " << learned.constants();
+        cout << " constant wires, " << learned.seconds() << " seconds." << endl;
+    }
 
-            // Error Checking
-            if (testMatrix->size() != inWires.size()) {
-                cout << "Error testMatrix is not the same size as inWires." << endl;
-                return;
+    // Generate the tests for the remaining faults in parallel, dropping the faults that each new test detects, then
+    // report all faults in the order of the fault file. droppedBy[f] is the fault whose PODEM test detected f.
+    TRACE(podemTrace.clear());
+    vector<int> source;
+    vector<podemResult> podemResults = runPODEMDropping(ckt, podemFaults, numThreads, pOptions,
+                                                        learnFlag ? &learned : nullptr, source);
+    vector<podemResult> results(bFaults.size());
+    vector<unsigned> podemIndex; // Fault file index of every fault PODEM had.
+    vector<int> droppedBy(bFaults.size(), -1);
+    unsigned podemRuns = 0, dropped = 0;
+    for (unsigned f = 0; f < bFaults.size(); f++) {
+        if (random.detectedBy[f] < 0) podemIndex.push_back(f);
+    }
+    for (unsigned f = 0, p = 0; f < bFaults.size(); f++) {
+        if (random.detectedBy[f] < 0) {
+            results[f] = podemResults[p];
+            if (source[p] >= 0 && (unsigned)source[p] != p) {
+                droppedBy[f] = podemIndex[source[p]];
+                dropped++;
             }
+            else podemRuns++;
+            p++;
+            continue;
+        }
+        results[f].status = DETECTED;
+        results[f].test = testCube::fromVector(random.vectors[random.detectedBy[f]]);
+    }
 
-            // Call simCircuit
-            cktInput.push_back(podemVector);
-            wStream << "\nDEDUCTIVE SIMULATION FOR " << bF.first << " s-a-" << bF.second << endl;
-            simCircuit(cktFile, cktInput); /// Deductive fault sim
+    // The SAT engine gets the faults that PODEM aborted: it proves redundancy without enumerating the PIs.
+    vector<bool> bySat(bFaults.size(), false);
+    unsigned satDecided = satFlag ? satFallback(ckt, bFaults, results, numThreads, sOptions, &bySat) : 0;
+    unsigned count[3] = {0, 0, 0}; // Detected, redundant and aborted faults.
+    unsigned long long backtracks = 0;
+
+    for (unsigned f = 0; f < bFaults.size(); f++) {
+        auto bF = bFaults[f];
+        count[results[f].status]++;
+        backtracks += results[f].backtracks;
+        if (results[f].status == DETECTED) { // If a vector was returned print it
+            if (random.detectedBy[f] >= 0) wStream << "\nPRINTING RANDOM TEST VECTOR " << random.detectedBy[f] + 1 << " FOR THE FAULT " << bF.first;
+            else if (bySat[f]) wStream << "\nPRINTING TEST VECTOR RETURNED BY THE SAT ENGINE FOR THE FAULT " << bF.first;
+            else if (droppedBy[f] >= 0) {
+                auto sF = bFaults[droppedBy[f]];
+                wStream << "\nTHE FAULT " << bF.first << " s-a-" << bF.second << " WAS DETECTED BY THE PODEM VECTOR FOR THE FAULT ";
+                wStream << sF.first << " s-a-" << sF.second << ".\n";
+                continue;
+            }
+            else wStream << "\nPRINTING TEST VECTOR RETURNED BY PODEM FOR THE FAULT " << bF.first;
+            wStream << " s-a-" << bF.second << ":\n";
+            wStream << results[f].test.toString() << "\n";
+
+            // The faults this vector (X inputs at 0) dropped, checked by the parallel-fault simulation.
+            if (random.detectedBy[f] >= 0 || bySat[f]) continue;
+            bool any = false;
+            for (unsigned d = 0; d < bFaults.size(); d++) {
+                if (droppedBy[d] != (int)f) continue;
+                if (!any) wStream << "FAULTS DROPPED BY THIS VECTOR:";
+                wStream << " " << bFaults[d].first << " s-a-" << bFaults[d].second;
+                any = true;
+            }
+            if (any) wStream << "\n";
+        }
+        else if (results[f].status == REDUNDANT && bySat[f]) {
+            wStream << "PODEM aborted, the SAT engine proved the fault " << bF.first << " s-a-" << bF.second;
+            wStream << " undetectable!\n";
+        }
+        else if (results[f].status == REDUNDANT) {
+            wStream << "PODEM failed, the fault " << bF.first << " s-a-" << bF.second << " is undetectable!\n";
         }
-        else wStream << "PODEM failed, the fault " << bF.first << " s-a-" << bF.second << " is undetectable!" << endl;
-        cout << endl;
+        else {
+            wStream << "PODEM aborted the fault " << bF.first << " s-a-" << bF.second << " after ";
+            wStream << results[f].backtracks << " backtracks";
+            if (satFlag) wStream << " and the SAT engine after " << sOptions.conflicts << " conflicts";
+            wStream << ".\n";
+        }
+    }
+
+    if (randomFlag) {
+        wStream << "\nTHE RANDOM PATTERN PHASE SIMULATED " << random.simulated << " VECTORS AND DETECTED " << random.detected;
+        wStream << " FAULTS WITH " << random.vectors.size() << " OF THEM, PODEM WAS RUN FOR " << podemFaults.size() << " FAULTS.\n";
+    }
+    wStream << "\n" << count[DETECTED] << " FAULTS WERE DETECTED, " << count[REDUNDANT] << " WERE PROVEN REDUNDANT AND ";
+    wStream << count[ABORTED] << " WERE ABORTED.\n";
+    wStream << "PODEM USED " << backtracks << " BACKTRACKS.\n";
+    wStream << "PODEM WAS RUN FOR " << podemRuns << " FAULTS, THE OTHER " << dropped;
+    wStream << " WERE DETECTED BY THEIR VECTORS AND DROPPED.\n";
+    if (satFlag) wStream << "THE SAT ENGINE DECIDED " << satDecided << " OF THE FAULTS THAT PODEM ABORTED.\n";
+    cout << count[DETECTED] << " detected, " << count[REDUNDANT] << " redundant, " << count[ABORTED] << " aborted, ";
+    cout << backtracks << " backtracks." << endl;
+#ifdef PODEM_TRACE
+    podemTrace.writeSummary(wStream);
+    if (!traceFile.empty() && !podemTrace.writeChromeTrace(traceFile)) cout << "Could not write the trace " << traceFile << endl;
+#endif
+
+    // One vector per fault is what the tester would have to apply without compaction.
+    vector<vector<bool>> compacted;
+    if (compactFlag && count[DETECTED]) {
+        compactStats stats;
+        compacted = compactTests(ckt, bFaults, results, pOptions, cOptions, stats);
+        wStream << "\nCOMPACTED TEST SET (" << compacted.size() << " VECTORS):\n";
+        for (auto &v: compacted) wStream << testCube::fromVector(v).toString() << "\n";
+        wStream << "PATTERN COUNT BEFORE COMPACTION: " << stats.initial << ", AFTER DYNAMIC COMPACTION: " << stats.dynamic;
+        wStream << ", AFTER MERGING: " << stats.merged << ", AFTER REVERSE ORDER FAULT SIMULATION: " << stats.final << "\n";
+        cout << "Pattern count: " << stats.initial << " before compaction, " << stats.final << " after." << endl;
+    }
+    if (!patternFile.empty()) writePatterns(results, droppedBy, compacted);
+}
 
-        podemVector.clear();
-        cktInput.clear();
-        if (testMatrix) testMatrix->clear();
+// Writes the test set and the status of every fault of bFaults to the pattern file. The patterns are the compacted
+// vectors, or without compaction the tests of the faults that got their own (the dropped faults share them).
+void writePatterns (const vector<podemResult> &results, const vector<int> &droppedBy,
+                    const vector<vector<bool>> &compacted) {
+    patternSet pSet;
+    pSet.PIs = ckt.PIs;
+    pSet.POs = ckt.POs;
+    pSet.faults = bFaults;
+    vector<pair<unsigned int, bool>> detected;
+    vector<unsigned> detectedIndex;
+    for (unsigned f = 0; f < bFaults.size(); f++) {
+        pSet.status.push_back(results[f].status);
+        if (results[f].status != DETECTED) continue;
+        detected.push_back(bFaults[f]);
+        detectedIndex.push_back(f);
+        if (!compactFlag && droppedBy[f] < 0) pSet.patterns.push_back(results[f].test);
+    }
+    for (auto &v: compacted) pSet.patterns.push_back(testCube::fromVector(v));
+
+    // The first pattern that detects every fault, with the X inputs at 0 like everywhere else.
+    vector<vector<bool>> vecs;
+    for (auto &p: pSet.patterns) vecs.push_back(p.toVector());
+    parallelFaultSim fSim(ckt, cktTape, max(1u, numThreads));
+    vector<int> first = fSim.firstDetection(detected, vecs);
+    pSet.detectedBy.assign(bFaults.size(), -1);
+    for (unsigned i = 0; i < detected.size(); i++) pSet.detectedBy[detectedIndex[i]] = first[i];
+
+    if (!writePatternFile(patternFile, pSet, asyncFlag)) {
+        cout << "Could not write the pattern file " << patternFile << endl;
     }
+    else cout << pSet.patterns.size() << " patterns written to " << patternFile << "." << endl;
 }
 
 void readVector() {
@@ -498,7 +723,7 @@ void readVector() {
     int bit, count = 1;
     vector<bool> userVector;
 
-    stream = fopen("userVector.txt", "r");
+    stream = fopen(vectorFile.c_str(), "r");
     if (stream == NULL) {
         printf("NULL\n");
         return;
@@ -0,0 +1,327 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Memory mapped netlist loader for the original circuit format and the ISCAS .bench format (see netlist.h).
+*/
+
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "netlist.h"
+
+mappedFile::mappedFile (const string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat st;
+    if (fstat(fd, &st) == 0) {
+        len = st.st_size;
+        if (len == 0) ok = true;
+        else {
+            void* m = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                ptr = static_cast<const char*>(m);
+                ok = mapped = true;
+            }
+        }
+    }
+
+    if (!ok) { // Not mappable (e.g. a pipe), read it instead.
+        char buf[1 << 16];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0) copy.append(buf, n);
+        ptr = copy.data();
+        len = copy.size();
+        ok = (n == 0);
+    }
+    close(fd);
+}
+
+mappedFile::~mappedFile() {
+    if (mapped) munmap(const_cast<char*>(ptr), len);
+}
+
+// Gate types of the parser. XOR and XNOR are not eGates, they are expanded into NAND gates when the circuit is built.
+enum eParsed {P_INV, P_BUF, P_AND, P_NAND, P_OR, P_NOR, P_XOR, P_XNOR, P_NONE};
+
+static eParsed gateKeyword (string_view t) {
+    if (t == "INV" || t == "NOT") return P_INV;
+    if (t == "BUF" || t == "BUFF") return P_BUF;
+    if (t == "AND") return P_AND;
+    if (t == "NAND") return P_NAND;
+    if (t == "OR") return P_OR;
+    if (t == "NOR") return P_NOR;
+    if (t == "XOR") return P_XOR;
+    if (t == "XNOR") return P_XNOR;
+    return P_NONE;
+}
+
+static eGate toGate (eParsed t) {
+    switch (t) {
+        case P_INV: return INV;
+        case P_BUF: return BUF;
+        case P_AND: return AND;
+        case P_NAND: return NAND;
+        case P_OR: return OR;
+        default: return NOR;
+    }
+}
+
+// Parses a positive decimal number without leading zeros. Returns 0 if t is not one.
+static unsigned wireNumber (string_view t) {
+    if (t.empty() || t.size() > 9 || t[0] == '0') return 0;
+    unsigned n = 0;
+    for (char ch: t) {
+        if (ch < '0' || ch > '9') return 0;
+        n = n*10 + (ch - '0');
+    }
+    return n;
+}
+
+static bool isSpace (char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; }
+
+// The parsed netlist before wire IDs are assigned. Wires are name indices (.bench) or wire IDs (original format).
+struct parsedNetlist {
+    vector<unsigned> inputs, outputs;
+    vector<eParsed> gType;
+    vector<unsigned> gStart{0}; // Wires of gate g are gWire[gStart[g]] .. gWire[gStart[g+1]-1], the output is last.
+    vector<unsigned> gWire;
+};
+
+static bool badLine (unsigned line, const char* msg) {
+    cout << "Line " << line << " of the circuit file: " << msg << endl;
+    return false;
+}
+
+// Ends the gate line that is being read. INV and BUF take exactly one input, the others at least one.
+static bool endGate (unsigned line, parsedNetlist &net) {
+    unsigned n = net.gWire.size() - net.gStart.back();
+    eParsed t = net.gType.back();
+    if (n < 2 || ((t == P_INV || t == P_BUF) && n != 2)) return badLine(line, "wrong number of wires for the gate.");
+    net.gStart.push_back(net.gWire.size());
+    return true;
+}
+
+// Original format. Gate lines end at the end of the line, INPUT and OUTPUT lists at -1.
+static bool parseOriginal (const char* p, const char* end, parsedNetlist &net) {
+    enum {NONE, IN_LIST, OUT_LIST, GATE} track = NONE;
+    unsigned line = 1;
+
+    while (p < end) {
+        while (p < end && isSpace(*p)) p++;
+        if (p == end) break;
+        if (*p == '\n') {
+            if (track == GATE) {
+                if (!endGate(line, net)) return false;
+                track = NONE;
+            }
+            line++;
+            p++;
+            continue;
+        }
+
+        const char* tok = p;
+        while (p < end && !isSpace(*p) && *p != '\n') p++;
+        string_view t(tok, p - tok);
+
+        if (t == "INPUT") track = IN_LIST;
+        else if (t == "OUTPUT") track = OUT_LIST;
+        else if (gateKeyword(t) != P_NONE && gateKeyword(t) < P_XOR) {
+            if (track == GATE) return badLine(line, "two gates on one line.");
+            net.gType.push_back(gateKeyword(t));
+            track = GATE;
+        }
+        else if (t == "-1") {
+            if (track == GATE) return badLine(line, "Invalid value from the input file.");
+            track = NONE; // End of an INPUT or OUTPUT list.
+        }
+        else {
+            unsigned id = wireNumber(t);
+            if (!id) return badLine(line, "Invalid value from the input file.");
+            if (track == IN_LIST) net.inputs.push_back(id);
+            else if (track == OUT_LIST) net.outputs.push_back(id);
+            else if (track == GATE) net.gWire.push_back(id);
+            else return badLine(line, "wire number outside of a gate, INPUT or OUTPUT line.");
+        }
+    }
+
+    if (track == GATE) return endGate(line, net); // No newline after the last gate.
+    return true;
+}
+
+// ISCAS .bench format. Every name is interned once, the wire lists hold name indices.
+static bool parseBench (const char* p, const char* end, parsedNetlist &net, vector<string_view> &names) {
+    unordered_map<string_view, unsigned> index;
+    index.reserve((end - p) / 16);
+    auto intern = [&](string_view n) {
+        auto it = index.emplace(n, names.size());
+        if (it.second) names.push_back(n);
+        return it.first->second;
+    };
+    auto isDelim = [](char ch) { return ch == '(' || ch == ')' || ch == ',' || ch == '=' || isSpace(ch); };
+
+    unsigned line = 0;
+    while (p < end) {
+        line++;
+        const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        const char* q = p;
+        const char* stop = static_cast<const char*>(memchr(p, '#', eol - p));
+        if (!stop) stop = eol;
+        p = eol + (eol < end);
+
+        // Splits the line into words, skipping the punctuation.
+        auto word = [&]() {
+            while (q < stop && isDelim(*q)) q++;
+            const char* w = q;
+            while (q < stop && !isDelim(*q)) q++;
+            return string_view(w, q - w);
+        };
+
+        string_view first = word();
+        if (first.empty()) continue;
+        if (first == "INPUT" || first == "OUTPUT") {
+            string_view n = word();
+            if (n.empty()) return badLine(line, "missing wire name.");
+            (first == "INPUT" ? net.inputs : net.outputs).push_back(intern(n));
+            continue;
+        }
+
+        const char* eq = static_cast<const char*>(memchr(q, '=', stop - q));
+        if (!eq) return badLine(line, "expected 'name = GATE(inputs)'.");
+        string_view kw = word();
+        eParsed t = gateKeyword(kw);
+        if (t == P_NONE) {
+            if (kw == "DFF") return badLine(line, "sequential elements (DFF) are not supported.");
+            return badLine(line, "unknown gate type.");
+        }
+
+        net.gType.push_back(t);
+        unsigned out = intern(first);
+        for (string_view n = word(); !n.empty(); n = word()) net.gWire.push_back(intern(n));
+        unsigned n = net.gWire.size() - net.gStart.back();
+        if (n < 1 || ((t == P_INV || t == P_BUF) && n != 1)) return badLine(line, "wrong number of inputs for the gate.");
+        net.gWire.push_back(out);
+        net.gStart.push_back(net.gWire.size());
+    }
+    return true;
+}
+
+// A .bench file by its extension, otherwise by its first line that is not blank: a '#' comment, "INPUT(" or
+// "name = GATE(" only occur in the .bench format.
+static bool isBench (const string &file, const char* p, const char* end) {
+    if (file.size() > 6 && file.compare(file.size() - 6, 6, ".bench") == 0) return true;
+    while (p < end && (isSpace(*p) || *p == '\n')) p++;
+    if (p == end) return false;
+    if (*p == '#') return true;
+    const char* eol = static_cast<const char*>(memchr(p, '\n', end - p));
+    if (!eol) eol = end;
+    return memchr(p, '(', eol - p) || memchr(p, '=', eol - p);
+}
+
+// Adds a two-input XOR of a and b driving out as four NAND gates. nextWire provides the internal wire IDs.
+static void addXor (circuit &c, unsigned a, unsigned b, unsigned out, unsigned &nextWire, vector<unsigned> &w) {
+    unsigned n1 = nextWire++, n2 = nextWire++, n3 = nextWire++;
+    w = {a, b, n1};
+    c.addGate(NAND, w);
+    w = {a, n1, n2};
+    c.addGate(NAND, w);
+    w = {b, n1, n3};
+    c.addGate(NAND, w);
+    w = {n2, n3, out};
+    c.addGate(NAND, w);
+}
+
+bool readCircuit (const string &file, circuit &c) {
+    mappedFile f(file);
+    if (!f.isOpen()) {
+        cout << "The stream did not open." << endl;
+        return false;
+    }
+    if (f.size() == 0) {
+        cout << "The circuit file is empty." << endl;
+        return false;
+    }
+
+    const char* p = f.data();
+    const char* end = p + f.size();
+    bool bench = isBench(file, p, end);
+
+    parsedNetlist net;
+    vector<string_view> names;
+    vector<unsigned> id; // Wire ID of every name (.bench only).
+    if (bench) {
+        if (!parseBench(p, end, net, names)) return false;
+
+        bool numeric = true;
+        id.resize(names.size());
+        for (unsigned i = 0; i < names.size() && numeric; i++) numeric = (id[i] = wireNumber(names[i])) != 0;
+        if (!numeric) for (unsigned i = 0; i < names.size(); i++) id[i] = i + 1;
+    }
+    else if (!parseOriginal(p, end, net)) return false;
+
+    auto wire = [&](unsigned w) { return bench ? id[w] : w; };
+
+    c.clear();
+    unsigned nextWire = 1; // First free wire ID for the internal wires of XOR/XNOR gates.
+    for (auto w: net.gWire) if (wire(w) >= nextWire) nextWire = wire(w) + 1;
+    for (auto w: net.inputs) if (wire(w) >= nextWire) nextWire = wire(w) + 1;
+
+    for (auto w: net.inputs) c.addInput(wire(w));
+
+    vector<unsigned> wires, tmp;
+    for (unsigned g = 0; g < net.gType.size(); g++) {
+        wires.clear();
+        for (unsigned i = net.gStart[g]; i < net.gStart[g+1]; i++) wires.push_back(wire(net.gWire[i]));
+        eParsed t = net.gType[g];
+        if (c.driverOf(wires.back()) != NO_GATE) {
+            cout << "The circuit contains a wire driven by more than one gate (wire " << wires.back() << ")." << endl;
+            c.clear(); // Nothing of a circuit that failed to load is used.
+            return false;
+        }
+        if (c.isPI(wires.back())) {
+            cout << "The circuit contains a primary input driven by a gate (wire " << wires.back() << ")." << endl;
+            c.clear();
+            return false;
+        }
+
+        if (t == P_XOR || t == P_XNOR) {
+            unsigned out = wires.back();
+            unsigned n = wires.size() - 1;
+            unsigned acc = wires[0];
+            if (n == 1) { // Single input XOR is a buffer (XNOR an inverter).
+                tmp = {acc, out};
+                c.addGate((t == P_XOR) ? BUF : INV, tmp);
+                continue;
+            }
+            for (unsigned i = 1; i < n; i++) {
+                bool last = (i == n - 1);
+                unsigned dst = (last && t == P_XOR) ? out : nextWire++;
+                addXor(c, acc, wires[i], dst, nextWire, tmp);
+                acc = dst;
+            }
+            if (t == P_XNOR) {
+                tmp = {acc, out};
+                c.addGate(INV, tmp);
+            }
+        }
+        else c.addGate(toGate(t), wires);
+    }
+
+    for (auto w: net.outputs) c.addOutput(wire(w));
+
+    if (!c.levelize()) {
+        cout << "The circuit contains a combinational loop." << endl;
+        c.clear();
+        return false;
+    }
+    c.computeScoap(); // Testability measures that guide PODEM.
+    return true;
+}
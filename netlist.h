@@ -0,0 +1,50 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Netlist loader. The circuit file is memory mapped and scanned in place (no getline/istringstream and no string per
+ token) straight into the levelized circuit. Two formats are accepted:
+ - The original format: one "GATE in1 .. inN out" line per gate (INV, BUF, AND, NAND, OR, NOR), with any number of
+   inputs, and "INPUT id .. -1" / "OUTPUT id .. -1" lines.
+ - The ISCAS .bench format: "INPUT(name)", "OUTPUT(name)" and "name = GATE(in1, .., inN)" with AND, NAND, OR, NOR,
+   NOT, BUF/BUFF, XOR and XNOR ('#' starts a comment). XOR/XNOR are built from NAND gates on new internal wires since
+   the simulators only know the eGate types. If every name is a positive number it is used as the wire ID, otherwise
+   the wires are numbered 1, 2, .. in the order the names first appear.
+ A file is read as .bench if its name ends in .bench or its first line that is not blank is a '#' comment or holds a
+ '(' or '='. Names are resolved through a hash index, and INPUT/OUTPUT declarations can appear anywhere in the file.
+*/
+
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <cstddef>
+#include <string>
+#include "circuit.h"
+
+// Read-only memory mapping of a whole file (falls back to reading it into memory if it cannot be mapped).
+class mappedFile {
+public:
+    explicit mappedFile (const string &path);
+    ~mappedFile();
+    mappedFile (const mappedFile&) = delete;
+    mappedFile &operator= (const mappedFile&) = delete;
+
+    bool isOpen() const { return ok; }
+    const char* data() const { return ptr; }
+    size_t size() const { return len; }
+
+private:
+    const char* ptr = nullptr;
+    size_t len = 0;
+    bool ok = false;
+    bool mapped = false;
+    string copy; // Used when the file could not be mapped.
+};
+
+// Reads the circuit file into c (which is cleared first), levelizes it and computes its SCOAP measures. Prints the
+// problem and returns false if the file cannot be read or is malformed.
+bool readCircuit (const string &file, circuit &c);
+
+#endif
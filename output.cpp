@@ -0,0 +1,122 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Buffered report and pattern file output (see output.h).
+*/
+
+#include <algorithm>
+#include <cstring>
+#include "output.h"
+
+bool outputBuffer::open (const string &path, bool inBackground) {
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    setvbuf(file, nullptr, _IONBF, 0); // The buffering is done here, in much larger blocks.
+    failed = false;
+    active.resize(size);
+    setp(active.data(), active.data() + active.size());
+
+    background = inBackground;
+    if (background) {
+        stopping = false;
+        writer = thread(&outputBuffer::writerLoop, this);
+    }
+    return true;
+}
+
+void outputBuffer::writerLoop() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [&]() { return stopping || !full.empty(); });
+        if (full.empty()) return; // Stopping, and everything was written.
+
+        vector<char> buffer = move(full.front());
+        full.pop_front();
+        guard.unlock();
+        bool ok = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+        guard.lock();
+        failed = failed || !ok;
+        spare.push_back(move(buffer));
+        drained.notify_one();
+    }
+}
+
+void outputBuffer::submit() {
+    size_t n = pptr() - pbase();
+    if (n && !background) failed = failed || (fwrite(pbase(), 1, n, file) != n);
+    else if (n) {
+        active.resize(n);
+        unique_lock<mutex> guard(lock);
+        drained.wait(guard, [&]() { return full.size() < MAX_QUEUED; });
+        full.push_back(move(active));
+        if (spare.empty()) active = vector<char>();
+        else {
+            active = move(spare.back());
+            spare.pop_back();
+        }
+        guard.unlock();
+        wake.notify_one();
+        active.resize(size);
+    }
+    setp(active.data(), active.data() + active.size());
+}
+
+outputBuffer::int_type outputBuffer::overflow (int_type ch) {
+    if (!file) return traits_type::eof();
+    submit();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+streamsize outputBuffer::xsputn (const char* s, streamsize n) {
+    if (!file) return 0;
+    streamsize left = n;
+    while (left > 0) {
+        streamsize room = epptr() - pptr();
+        if (!room) {
+            submit();
+            continue;
+        }
+        streamsize k = min(room, left);
+        memcpy(pptr(), s, k);
+        pbump(k);
+        s += k;
+        left -= k;
+    }
+    return n;
+}
+
+bool outputBuffer::close() {
+    if (!file) return true;
+    submit();
+    if (background) {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        writer.join();
+        full.clear();
+        spare.clear();
+        background = false;
+    }
+    bool ok = !failed && (fclose(file) == 0);
+    file = nullptr;
+    active = vector<char>();
+    setp(nullptr, nullptr);
+    return ok;
+}
+
+bool reportStream::open (const string &path, bool background) {
+    bool ok = buf.open(path, background);
+    if (ok) clear();
+    else setstate(ios::failbit);
+    return ok;
+}
@@ -0,0 +1,75 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Buffered output for the reports and pattern files. Reports are written a line at a time, and on runs with millions of
+ faults a flush per line (every endl on an fstream) makes the program I/O bound. reportStream is an ostream over a
+ large buffer that only goes to the file when it is full or the stream is closed, so endl costs no more than '\n'.
+ With a background writer, a full buffer is handed to a writer thread and the program keeps formatting into a spare
+ one; the number of buffers in flight is bounded, so a slow disk holds the program back instead of using up memory.
+*/
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class outputBuffer : public streambuf {
+public:
+    explicit outputBuffer (size_t bufferSize = 1 << 20) : size(bufferSize) {}
+    ~outputBuffer() { close(); }
+    outputBuffer (const outputBuffer&) = delete;
+    outputBuffer &operator= (const outputBuffer&) = delete;
+
+    bool open (const string &path, bool background);
+    bool close(); // Writes what is left and closes the file. Returns false if a write failed.
+    bool isOpen() const { return file != nullptr; }
+
+protected:
+    int_type overflow (int_type ch) override;
+    streamsize xsputn (const char* s, streamsize n) override;
+    int sync() override { return 0; } // endl does not write, the buffer goes out when it is full.
+
+private:
+    void submit(); // Hands the filled part of the buffer to the writer (or writes it) and starts an empty one.
+    void writerLoop();
+
+    size_t size;
+    FILE* file = nullptr;
+    bool failed = false;
+    vector<char> active;
+
+    // Background writer.
+    bool background = false, stopping = false;
+    thread writer;
+    mutex lock;
+    condition_variable wake, drained;
+    deque<vector<char>> full; // Buffers waiting to be written, oldest first.
+    vector<vector<char>> spare;
+    static const unsigned MAX_QUEUED = 4;
+};
+
+class reportStream : public ostream {
+public:
+    reportStream() : ostream(nullptr) { rdbuf(&buf); }
+
+    bool open (const string &path, bool background = false);
+    bool close() { return buf.close(); }
+    bool is_open() const { return buf.isOpen(); }
+
+private:
+    outputBuffer buf;
+};
+
+#endif
@@ -0,0 +1,169 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Binary pattern and fault status files (see patfile.h).
+*/
+
+#include <cstring>
+#include "cktimage.h"
+#include "netlist.h"
+#include "output.h"
+#include "patfile.h"
+
+struct patternHeader {
+    char magic[8]; // "PODEMPAT"
+    uint32_t version;
+    uint32_t headerSize;
+    uint64_t numPatterns;
+    uint64_t numFaults;
+    uint64_t fileSize; // Whole file, to catch truncated files.
+};
+
+static const char PATTERN_MAGIC[8] = {'P', 'O', 'D', 'E', 'M', 'P', 'A', 'T'};
+static const char* statusText[3] = {"DETECTED", "REDUNDANT", "ABORTED"};
+
+// Bytes that an array of count elements of the given size takes in the file.
+static uint64_t arrayBytes (uint64_t count, uint64_t elementSize) {
+    uint64_t bytes = count * elementSize;
+    return sizeof(uint64_t) + bytes + (8 - bytes % 8) % 8;
+}
+
+static void putPadding (ostream &out, uint64_t bytes) {
+    static const char zeros[8] = {0};
+    out.write(zeros, (8 - bytes % 8) % 8);
+}
+
+// Writes one array (count, elements, padding) the way getArray reads it.
+template <typename T>
+static void putArray (ostream &out, const vector<T> &v) {
+    uint64_t count = v.size();
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    out.write(reinterpret_cast<const char*>(v.data()), count * sizeof(T));
+    putPadding(out, count * sizeof(T));
+}
+
+// Writes the care (care = true) or value plane of every pattern as one array.
+static void putPlane (ostream &out, const vector<testCube> &patterns, unsigned words, bool care) {
+    uint64_t count = (uint64_t) patterns.size() * words;
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (auto &p: patterns) {
+        const uint64_t* w = care ? p.careWords() : p.valueWords();
+        out.write(reinterpret_cast<const char*>(w), words * sizeof(uint64_t));
+    }
+}
+
+bool writePatternFile (const string &path, const patternSet &pSet, bool background) {
+    unsigned words = (pSet.PIs.size() + 63) / 64;
+    for (auto &p: pSet.patterns) {
+        if (p.size() != pSet.PIs.size()) return false;
+    }
+
+    vector<uint32_t> PIs(pSet.PIs.begin(), pSet.PIs.end()), POs(pSet.POs.begin(), pSet.POs.end()), wires;
+    vector<uint8_t> flags; // Bit 0 is the stuck-at value, bits 1 and 2 the status.
+    vector<int32_t> detectedBy(pSet.detectedBy.begin(), pSet.detectedBy.end());
+    for (unsigned f = 0; f < pSet.faults.size(); f++) {
+        wires.push_back(pSet.faults[f].first);
+        flags.push_back(pSet.faults[f].second | (pSet.status[f] << 1));
+    }
+
+    patternHeader h;
+    memcpy(h.magic, PATTERN_MAGIC, sizeof(h.magic));
+    h.version = PATTERN_FILE_VERSION;
+    h.headerSize = sizeof(patternHeader);
+    h.numPatterns = pSet.patterns.size();
+    h.numFaults = pSet.faults.size();
+    h.fileSize = sizeof(patternHeader) + arrayBytes(PIs.size(), 4) + arrayBytes(POs.size(), 4) +
+                 2 * arrayBytes(h.numPatterns * words, 8) + arrayBytes(h.numFaults, 4) + arrayBytes(h.numFaults, 1) +
+                 arrayBytes(h.numFaults, 4);
+
+    reportStream out;
+    if (!out.open(path, background)) return false;
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    putArray(out, PIs);
+    putArray(out, POs);
+    putPlane(out, pSet.patterns, words, true);
+    putPlane(out, pSet.patterns, words, false);
+    putArray(out, wires);
+    putArray(out, flags);
+    putArray(out, detectedBy);
+    return out.close();
+}
+
+bool readPatternFile (const string &path, patternSet &pSet, string &error) {
+    mappedFile file(path);
+    if (!file.isOpen()) {
+        error = "The pattern file " + path + " could not be opened.";
+        return false;
+    }
+    patternHeader h;
+    if (file.size() < sizeof(h)) {
+        error = path + " is not a pattern file.";
+        return false;
+    }
+    memcpy(&h, file.data(), sizeof(h));
+    if (memcmp(h.magic, PATTERN_MAGIC, sizeof(h.magic)) != 0) {
+        error = path + " is not a pattern file.";
+        return false;
+    }
+    if (h.version != PATTERN_FILE_VERSION || h.headerSize != sizeof(h)) {
+        error = path + " was written by another version of the program.";
+        return false;
+    }
+
+    const char* p = file.data() + sizeof(h);
+    const char* end = file.data() + file.size();
+    vector<uint32_t> PIs, POs, wires;
+    vector<uint64_t> care, value;
+    vector<uint8_t> flags;
+    vector<int32_t> detectedBy;
+    bool ok = (h.fileSize == file.size()) && getArray(p, end, PIs) && getArray(p, end, POs) &&
+              getArray(p, end, care) && getArray(p, end, value) && getArray(p, end, wires) &&
+              getArray(p, end, flags) && getArray(p, end, detectedBy);
+
+    // The arrays have to fit together, otherwise the file is damaged.
+    unsigned words = (PIs.size() + 63) / 64;
+    ok = ok && (care.size() == h.numPatterns * words) && (value.size() == care.size()) &&
+         (wires.size() == h.numFaults) && (flags.size() == h.numFaults) && (detectedBy.size() == h.numFaults);
+    for (unsigned f = 0; f < flags.size() && ok; f++) {
+        ok = ((flags[f] >> 1) <= ABORTED) && (detectedBy[f] >= -1) && (detectedBy[f] < (int64_t) h.numPatterns);
+    }
+    if (!ok) {
+        error = "The pattern file " + path + " is damaged.";
+        return false;
+    }
+
+    pSet = patternSet();
+    pSet.PIs.assign(PIs.begin(), PIs.end());
+    pSet.POs.assign(POs.begin(), POs.end());
+    pSet.patterns.resize(h.numPatterns);
+    for (uint64_t i = 0; i < h.numPatterns; i++) {
+        pSet.patterns[i].assign(PIs.size(), care.data() + i * words, value.data() + i * words);
+    }
+    for (unsigned f = 0; f < wires.size(); f++) {
+        pSet.faults.push_back(make_pair(wires[f], (bool) (flags[f] & 1)));
+        pSet.status.push_back(static_cast<eFaultStatus>(flags[f] >> 1));
+    }
+    pSet.detectedBy.assign(detectedBy.begin(), detectedBy.end());
+    return true;
+}
+
+void writePatternText (ostream &out, const patternSet &pSet) {
+    out << pSet.patterns.size() << " PATTERNS OVER " << pSet.PIs.size() << " INPUTS AND " << pSet.POs.size();
+    out << " OUTPUTS, " << pSet.faults.size() << " FAULTS.\n";
+    out << "INPUTS:";
+    for (auto w: pSet.PIs) out << " " << w;
+    out << "\nOUTPUTS:";
+    for (auto w: pSet.POs) out << " " << w;
+    out << "\n";
+    for (unsigned i = 0; i < pSet.patterns.size(); i++) {
+        out << "PATTERN " << i + 1 << ": " << pSet.patterns[i].toString() << "\n";
+    }
+    for (unsigned f = 0; f < pSet.faults.size(); f++) {
+        out << "FAULT " << pSet.faults[f].first << " s-a-" << pSet.faults[f].second << " " << statusText[pSet.status[f]];
+        if (pSet.detectedBy[f] >= 0) out << " BY PATTERN " << pSet.detectedBy[f] + 1;
+        out << "\n";
+    }
+}
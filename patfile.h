@@ -0,0 +1,46 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Binary pattern and fault status file, written next to the text report (--patterns FILE) and turned back into text
+ with --convert FILE. Behind a versioned header come flat arrays, 8-byte aligned like the circuit image (cktimage.h)
+ and in the native byte order:
+ - the primary input and primary output wire IDs, in the order of the pattern bits,
+ - the care and value planes of every pattern, packed 64 inputs per word (see cube.h: an input is X if its care bit
+   is 0), so a test set takes 2 bits per input and pattern,
+ - the wire, the stuck-at value and status and the first detecting pattern (-1 if none) of every fault.
+ The file is written through a reportStream, so a large test set goes out in large blocks.
+*/
+
+#ifndef PATFILE_H
+#define PATFILE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "cube.h"
+#include "podem.h"
+
+const uint32_t PATTERN_FILE_VERSION = 1;
+
+struct patternSet {
+    vector<unsigned> PIs, POs;
+    vector<testCube> patterns; // Every pattern has PIs.size() inputs.
+    vector<pair<unsigned int, bool>> faults;
+    vector<eFaultStatus> status; // Of every fault.
+    vector<int> detectedBy; // Index of the first pattern that detects every fault, -1 if none does.
+};
+
+// Returns false if the file could not be written.
+bool writePatternFile (const string &path, const patternSet &pSet, bool background = false);
+
+// Returns false (with a message in error) if the file is missing, from another version or damaged.
+bool readPatternFile (const string &path, patternSet &pSet, string &error);
+
+// Text form of a pattern file: the PI/PO order, one line of 0/1/X per pattern and one line per fault.
+void writePatternText (ostream &out, const patternSet &pSet);
+
+#endif
@@ -1,262 +1,550 @@
 /*
  Author: Chibudem [Christian] Offodile
- Date last modified: 11/25/2023
+ Date last modified: 10/16/2026
  Class: ECE 6140-A
 
  Description:
  Fault-oriented test vector generation function based on the PODEM (Path Oriented Decision Making) test generation
  algorithm [for digital logic circuits]. The inputs to the program are a logic circuit and a target fault within the
  circuit. The logic circuit will be input in a txt file but the txt file will be processed by a separate function and
- passed into this function as a linked list of gates. The target fault will be input from a txt file (targetFaultRead
- function can read target faults from an input file).
- The output of the function is a pointer to a test vector that would detect the target fault.
+ passed into this function as a levelized circuit (see circuit.h). The target fault will be input from a txt file
+ (targetFaultRead function can read target faults from an input file).
+ The output of the function is a test vector that would detect the target fault.
+ The circuit is never copied or modified: every PODEM run keeps its wire values, D-Frontier and test vector in a
+ podemContext, so independent faults can be processed by several threads at once (runPODEM).
 */
 
+#include <algorithm>
+#include <chrono>
 #include "podem.h"
 
-// GLOBAL VARIABLES
-bool errorAtPO; // initialize to false
-int8_t fLine; // If l has value v, l s-a-v is undetectable, initialize to x (-1)
-list<gate> gateList;
-fault tFault (false, 0);
-list<gate*> DFrontier;
-unsigned int recCount = 0; // Recursion counter
-list<pair<unsigned, int8_t>> testVector;
-
-// PODEM FUNCTION DEFINITIONS
-
-list<pair<unsigned, int8_t>>* PODEM (list<gate>* pGateList, const vector<unsigned>* pInWires, const fault* pFault) {
-    recCount++;
-    // If it is the first call set up the global variables and increment the recursion counter.
-    if (pGateList && pInWires && pFault) {
-        gateList = *pGateList; // Make a copy of the circuit then throw away the pointer.
-        pGateList = nullptr;
-        tFault = *pFault; // Make a copy of the target fault
-        errorAtPO = false;
-        fLine = -1;
-        DFrontier.clear();
-        testVector.clear();
-
-        for (int i = 0; i < pInWires->size(); i++) {
-            // Add each input wire to the testVector in an invalidated (X) -> (-1) state.
-            pair<unsigned int, int8_t> newIn;
-            newIn.first = pInWires->at(i);
-            newIn.second = -1;
-            testVector.push_back(newIn);
-
-            // Find the PIs in the circuit and set their isPI bool to true.
-            for (auto g = gateList.begin(); g != gateList.end(); g++) {
-                g->setPI(pInWires->at(i)); // setPI does nothing if none of the gate's input wires match the wire ID that was passed in.
-
-                // Mark the target fault wire in the circuit using setFaultSim (only needs to be done once).
-                // setFaultSim does nothing if none of the gate's wires match the wire ID that was passed in.
-                if (i == pInWires->size()-1) {
-                    unsigned int faultWire = tFault.getFaultWire();
-                    if ((g->getOutputID() == faultWire) || g->isPInput(faultWire)) g->setFaultSim(faultWire);
+// 3-valued (0, 1, X = -1) evaluation of gate g in one machine (good or faulty).
+static int8_t evalGate3 (const circuit &c, unsigned g, const vector<int8_t> &val) {
+    const unsigned* in = c.fanin(g);
+    unsigned n = c.numFanin(g);
+    int8_t r;
+    switch (c.type[g]) {
+        case AND:
+        case NAND:
+            r = 1;
+            for (unsigned i = 0; i < n; i++) {
+                if (val[in[i]] == 0) {
+                    r = 0;
+                    break;
                 }
+                if (val[in[i]] < 0) r = -1;
             }
-        }
+            return (c.type[g] == NAND && r >= 0) ? !r : r;
+        case OR:
+        case NOR:
+            r = 0;
+            for (unsigned i = 0; i < n; i++) {
+                if (val[in[i]] == 1) {
+                    r = 1;
+                    break;
+                }
+                if (val[in[i]] < 0) r = -1;
+            }
+            return (c.type[g] == NOR && r >= 0) ? !r : r;
+        case INV:
+            return (val[in[0]] < 0) ? -1 : !val[in[0]];
+        default: // BUF
+            return val[in[0]];
     }
+}
 
-    else if (recCount == 1) { // 1st call but not all pointers were passed
-        cout << "PODEM called in main with invalid arguements" << endl; // Some arguements were NULL for the first call to PODEM (in main).
-        return nullptr;
-    }
+static bool cValue (eGate t) { return (t == OR) || (t == NOR); } // Controlling value (the value of an INV/BUF input is irrelevant).
+static bool invParity (eGate t) { return (t == NAND) || (t == NOR) || (t == INV); }
 
-    /// DEBUG - Break out of possible infinite recursion
-    if (recCount > gateList.size()*10) {
-        cout << "PODEM crash, recursion count: " << recCount << endl;
-        return nullptr;
-    }
+// PODEM FUNCTION DEFINITIONS
 
-    if (errorAtPO) return &testVector;
+podemContext::podemContext (const circuit &cRef, const staticLearning *learned)
+    : c(cRef), learning(learned), engine(cRef, learned) {
+    eventQueue.resize(c.maxLevel + 1);
+    queued.assign(c.numGates(), false);
+    xPath.assign(c.numWires(), false);
+    inCone.assign(c.numWires(), false);
+    if (learning) need.assign(c.numWires(), -1);
+}
+
+eFaultStatus podemContext::run (unsigned wireID, bool sa) {
+    static const testCube noCube;
+    return run(wireID, sa, noCube);
+}
 
-    // The D frontier will be empty on the 1st call because imply has not been called yet. If the fault was not excited
-    // or it was excited but cannot be propagated, return false.
-    if (recCount > 1) {
-        if ((fLine == tFault.getFault()) || ((fLine == !tFault.getFault()) && DFrontier.empty())) return nullptr;
+eFaultStatus podemContext::run (unsigned wireID, bool sa, const testCube &cube) {
+    faultWire = wireID;
+    faultValue = sa;
+    good.assign(c.numWires(), -1);
+    faulty.assign(c.numWires(), -1);
+    fLine = -1;
+    dAtPO = 0;
+    DFrontier.clear();
+    decisions.clear();
+    numBacktracks = 0;
+    violated = 0;
+    nextRequired = 0;
+    TRACE(stats = faultCounters());
+    TRACE(stats.wire = wireID; stats.sa = sa; stats.start = podemTrace.now());
+    faultCone();
+
+    // Inject the fault: the faulty machine value of the fault line is stuck from the start. This happens before the
+    // first decision so it is never rolled back.
+    if (assignWire(faultWire, -1, -1)) schedule(faultWire);
+    propagate();
+
+    // The specified bits of the cube are fixed the same way, so the search only decides the X inputs.
+    cube.forEachSpecified([&](unsigned i, bool v) { imply(c.PIs[i], v); });
+    trail.clear();
+    dfTrail.clear();
+    initXPath();
+
+    eFaultStatus status = (learning && !mandatorySetup(cube)) ? REDUNDANT : PODEM();
+
+    // The decisions that produced the test (and the cube) are the PI values, PIs are never implied from anything else.
+    testVector.reset(c.PIs.size());
+    if (status == DETECTED) {
+        for (unsigned i = 0; i < c.PIs.size(); i++) {
+            if (good[c.PIs[i]] >= 0) testVector.set(i, good[c.PIs[i]]);
+        }
     }
+    TRACE(stats.status = status; stats.backtracks = numBacktracks; stats.micros = podemTrace.now() - stats.start);
+    return status;
+}
+
+/*
+ * PODEM Pseudocode:
+ * Repeat: if the error reached a primary output, the PI assignments are a test. If the fault can still be excited and
+ * propagated, pick an objective, backtrace it to a PI, push the PI assignment on the decision stack and imply it.
+ * Otherwise backtrack: pop the decisions whose two values have both been tried and flip the newest one that has not.
+ * If the stack runs empty, every PI assignment has been ruled out and the fault is redundant. The backtrack limit and
+ * time budget abort the search for faults that are too hard.
+ */
+eFaultStatus podemContext::PODEM() {
+    auto start = chrono::steady_clock::now();
+
+    while (true) {
+        if (dAtPO) return DETECTED;
+
+        // If the fault was not excited or it was excited but cannot be propagated, backtrack. With the X-path check the
+        // fault can also not be propagated when the fault site (before excitation) or every D-Frontier gate has no
+        // X-path left.
+        dGate = frontierGate();
+        bool blocked = options.xPath && (((fLine == -1) && !xPath[faultWire]) ||
+                                         ((fLine == !faultValue) && (dGate == NO_GATE) && !DFrontier.empty()));
+        bool conflict = (fLine == faultValue) || ((fLine == !faultValue) && DFrontier.empty()) || blocked;
+        TRACE(if (blocked) stats.xPathConflicts++);
+        pair<unsigned int, bool> goal(0, false);
+        if (!conflict && learning) conflict = !mandatory(goal);
+
+        if (!conflict) {
+            if (!goal.first) goal = objective();
+            pair<unsigned int, bool> PI(0, false);
+            if (goal.first) PI = backtrace(goal.first, goal.second);
+
+            if (goal.first && c.isPI(PI.first)) {
+                decisions.push_back({PI.first, PI.second, false, trail.size(), dfTrail.size(), xpTrail.size(), nextRequired});
+                imply(PI.first, PI.second);
+                TRACE(stats.decisions++);
+                continue;
+            }
+        }
 
-    pair<unsigned int, bool> goal = objective();
-    pair<unsigned int, bool> PI = backtrace(goal.first, goal.second);
-    list<fault> emptyList; // Empty fault list for non recursive call to imply
-    imply (PI.first, PI.second, true, emptyList);
-    cout << "Corresponding input assignment: Wire: " << PI.first << " = logic " << PI.second << endl;
+        // Undo the decisions that were already reversed, then reverse the newest one that was not.
+        while (!decisions.empty() && decisions.back().flipped) {
+            rollback(decisions.back().wireMark, decisions.back().dfMark, decisions.back().xpMark);
+            decisions.pop_back();
+        }
+        if (decisions.empty()) return REDUNDANT;
 
-    // If imply was successful, change the value of the wire in the testvector list and return it.
-    if (PODEM(nullptr, nullptr, nullptr)) {
-        for (auto piTest = testVector.begin(); piTest != testVector.end(); piTest++) {
-            if (piTest->first == PI.first) piTest->second = PI.second;
+        numBacktracks++;
+        if (options.backtracks && numBacktracks > options.backtracks) return ABORTED;
+        if ((options.seconds > 0.0) && ((numBacktracks & 63) == 0)) {
+            chrono::duration<double> used = chrono::steady_clock::now() - start;
+            if (used.count() > options.seconds) return ABORTED;
         }
-        if (pInWires && pFault) recCount = 0; // If this was the first PODEM call (from main) reset recCount.
-        return &testVector;
+
+        /* Reverse decision and check. */
+        decision &d = decisions.back();
+        rollback(d.wireMark, d.dfMark, d.xpMark);
+        nextRequired = d.reqMark;
+        d.value = !d.value;
+        d.flipped = true;
+        imply(d.wire, d.value);
     }
+}
 
-    /* Reverse decision and check (run PODEM). */
-    imply (PI.first, false, false, emptyList); // invalidate path before re-simulating with flipped bit.
-    imply (PI.first, !PI.second, true, emptyList);
-    cout << "Corresponding input assignment: Wire: " << PI.first << " = logic " << !PI.second << endl;
-    if (PODEM(nullptr, nullptr, nullptr)) {
-        for (auto piTest = testVector.begin(); piTest != testVector.end(); piTest++) {
-            if (piTest->first == PI.first) piTest->second = !PI.second;
+// Returns the input of g that is X in the good machine (or, failing that, in the faulty machine) and that is the
+// easiest (or the hardest) to set to value according to SCOAP. Without SCOAP the first X input is returned. 0 is not a
+// valid wire ID so a return of 0 means that g has no X input.
+unsigned podemContext::xInput (unsigned g, bool value, bool hardest) const {
+    const unsigned* in = c.fanin(g);
+    const vector<unsigned> &cc = value ? c.CC1 : c.CC0;
+    unsigned best = 0;
+    for (int pass = 0; pass < 2 && !best; pass++) {
+        const vector<int8_t> &val = (pass == 0) ? good : faulty;
+        for (unsigned i = 0; i < c.numFanin(g); i++) {
+            if (val[in[i]] >= 0) continue;
+            if (!options.scoap) return in[i];
+            if (!best || (hardest ? cc[in[i]] > cc[best] : cc[in[i]] < cc[best])) best = in[i];
         }
-        if (pInWires && pFault) recCount = 0;
-        return &testVector;
     }
+    return best;
+}
 
-    imply (PI.first, false, false, emptyList); // Run forward "invalidation simulation"
-    if (pInWires && pFault) recCount = 0;
-    return nullptr;
+// D-Frontier ordering key of gate g: its output observability, then its index.
+pair<unsigned, unsigned> podemContext::dfKey (unsigned g) const {
+    return make_pair(options.scoap ? c.CO[c.outWire[g]] : 0, g);
 }
 
 //
-pair<unsigned int, bool> objective() {
-    pair<unsigned int, bool> obj;
+pair<unsigned int, bool> podemContext::objective() {
+    pair<unsigned int, bool> obj(0, false);
     if (fLine == -1) { // return (l, !v) if l is x
-        obj.first = tFault.getFaultWire();
-        obj.second = !tFault.getFault();
-        cout << "Recursion Level: " << recCount << "\nObjective: Wire: " << obj.first << " = logic " << obj.second << endl;
+        obj.first = faultWire;
+        obj.second = !faultValue;
         return obj;
     }
 
-    /// DEBUG
-    if (DFrontier.empty()) {
-        cout << "Objective called with an empty D-Frontier and l != x." << endl;
-        return obj;
-    }
+    if (dGate == NO_GATE) return obj;
 
-    gate D = *DFrontier.front();
-    obj.first = D.getInputInv();
-    obj.second = !D.cValue();
-    cout << "Recursion Level: " << recCount << "\nObjective: Wire: " << obj.first << " = logic " << obj.second << endl;
+    // Every X input of the most observable D-Frontier gate with an X-path needs the non-controlling value, so start
+    // with the hardest.
+    unsigned D = dGate;
+    obj.second = !cValue(c.type[D]);
+    obj.first = xInput(D, obj.second, true);
     return obj;
 }
 
+// Fanout cone of the fault site, sorted from the highest level down (the flags of the previous fault are cleared).
+void podemContext::faultCone() {
+    for (auto w: coneWires) {
+        inCone[w] = false;
+        xPath[w] = false;
+    }
+    coneWires.assign(1, faultWire);
+    inCone[faultWire] = true;
+    for (size_t i = 0; i < coneWires.size(); i++) {
+        const unsigned* fo = c.fanout(coneWires[i]);
+        for (unsigned j = 0; j < c.numFanout(coneWires[i]); j++) {
+            unsigned o = c.outWire[fo[j]];
+            if (inCone[o]) continue;
+            inCone[o] = true;
+            coneWires.push_back(o);
+        }
+    }
+    auto level = [&](unsigned w) { return (c.driverOf(w) == NO_GATE) ? 0 : c.level[c.driverOf(w)]; };
+    sort(coneWires.begin(), coneWires.end(), [&](unsigned a, unsigned b) { return level(a) > level(b); });
+}
+
+// Mandatory assignments of the fault. Returns false if they conflict, which proves the fault redundant (or, with a
+// cube, that no test agrees with the cube).
+bool podemContext::mandatorySetup (const testCube &cube) {
+    for (auto &r: required) need[r.first] = -1;
+    required.clear();
+    if (learning->idom(faultWire) == DOM_NONE) return false; // No primary output can observe the fault site.
+
+    engine.reset();
+    bool ok = engine.assign(faultWire, !faultValue);
+    cube.forEachSpecified([&](unsigned i, bool v) { ok = ok && engine.assign(c.PIs[i], v); });
+    for (unsigned d = learning->idom(faultWire); d != DOM_OUTPUT && ok; d = learning->idom(d)) {
+        unsigned g = c.driverOf(d);
+        if (c.type[g] == INV || c.type[g] == BUF) continue;
+        const unsigned* in = c.fanin(g);
+        for (unsigned i = 0; i < c.numFanin(g) && ok; i++) {
+            if (!inCone[in[i]]) ok = engine.assign(in[i], !cValue(c.type[g]));
+        }
+    }
+    if (ok) {
+        for (auto w: engine.assigned()) {
+            required.push_back(make_pair(w, (bool) engine.value(w)));
+            need[w] = engine.value(w);
+            if (good[w] == !need[w]) violated++;
+        }
+    }
+    engine.reset();
+    return ok;
+}
+
+// Checks the mandatory assignments against the current good machine values. Returns false if one is contradicted;
+// otherwise goal is set to the first one that is still X and can be justified (it is left alone if there is none).
+// Values only go from X to known between backtracks, so the mandatory assignments that were skipped stay set.
+bool podemContext::mandatory (pair<unsigned int, bool> &goal) {
+    if (violated) return false;
+    while (nextRequired < required.size()) {
+        unsigned w = required[nextRequired].first;
+        if (good[w] < 0 && (c.isPI(w) || c.driverOf(w) != NO_GATE)) break;
+        nextRequired++;
+    }
+    if (nextRequired < required.size()) goal = required[nextRequired];
+
+    // A single D-Frontier gate: the error has to go through its output and then through every dominator of it.
+    if ((fLine == !faultValue) && (DFrontier.size() == 1)) {
+        unsigned o = c.outWire[DFrontier.begin()->second];
+        if (learning->idom(o) == DOM_NONE) return false;
+        for (unsigned d = learning->idom(o); d != DOM_OUTPUT; d = learning->idom(d)) {
+            if (!sideInputs(d, goal)) return false;
+        }
+    }
+    return true;
+}
+
+// The side inputs of the gate that drives dominator domWire need their non-controlling value.
+bool podemContext::sideInputs (unsigned domWire, pair<unsigned int, bool> &goal) {
+    unsigned g = c.driverOf(domWire);
+    if (c.type[g] == INV || c.type[g] == BUF) return true;
+    bool nc = !cValue(c.type[g]);
+    const unsigned* in = c.fanin(g);
+    for (unsigned i = 0; i < c.numFanin(g); i++) {
+        if (inCone[in[i]]) continue;
+        if (good[in[i]] == !nc) return false;
+        if (good[in[i]] < 0 && !goal.first) goal = make_pair(in[i], nc);
+    }
+    return true;
+}
 
 /*
  * Backtrace Pseudocode:
- * In an infinite loop, search through the gateList for the objective wireID. If the objective wireID is a primary
- * input, return the PI so the imply function can simulate that PI. If it's not a PI, the objective wireID must
- * correspond to the output of a gate (not fanout input nodes) for backtracing to be possible. There should only be one
- * output gate corresponding to this wireID. Once this output gate is found, check for an invalid input on the gate and
- * use the wire number of that input as the next "X line" to continue backtracing from. Compute the new value based on
- * the inversion parity of the gate and break the for loop. The while loop restarts the for loop but this time with a
- * new wire ID and value and everything repeats until a primary input is reached.
- * If the X path tracing does not converge, there are two possibilities.
- * One is that the output gate was found but had no invalid inputs for backtracing. The second is that some bug was
- * encountered that caused the loop to run infinitely, the counter will end the loop after an "excesiive" number of
- * iterations.
+ * Starting from the objective wireID, look the wire up in the circuit. If the objective wireID is a primary input,
+ * return the PI so the imply function can simulate that PI. If it's not a PI, the objective wireID must correspond to
+ * the output of a gate (not fanout input nodes) for backtracing to be possible; that gate is found through the driver
+ * table. Check for an invalid input on the gate and use the wire number of that input as the next "X line" to continue
+ * backtracing from. Compute the new value based on the inversion parity of the gate and repeat until a primary input
+ * is reached. Every step goes down at least one level, so the loop is bounded by the depth of the circuit.
  */
-pair<unsigned int, bool> backtrace (unsigned int wireID, bool value) {
-    pair<unsigned int, bool> PIWire;
-    PIWire.first = wireID;
-    PIWire.second = value;
-    unsigned int count = 0;
-
-    // "Infinite loop"
-    while (count < gateList.size()) {
-        // Find wire in ckt list.
-        for (auto g = gateList.begin(); g != gateList.end(); g++) {
-            if (g->isPInput(PIWire.first)) { // If the wire is a primary input
-                return PIWire;
-            }
-
-            if (g->getOutputID() == PIWire.first) { // If the wire is the output wire of g.
-                // Check if any of g's inputs are invalid (X) and use that input as the next wire ID.
-                unsigned int tempWire = g->getInputInv();
-                if (tempWire) { // 0 is not a valid wire ID so a return of 0 means failure
-                    PIWire.first = tempWire; // use this "X line" to continue backtracing.
-                    PIWire.second = PIWire.second ^ g->invParity(); // v = v xor i
-                    break; // Since I found the gate I can break the for loop.
-                }
-
-                else { // This should never happen if the other functions work properly.
-                    cout << "Found the correct wire node, but there is no X path to a PI." << endl;
-                    return PIWire;
-                }
-            }
-        }
-        count++;
+pair<unsigned int, bool> podemContext::backtrace (unsigned int wireID, bool value) {
+    pair<unsigned int, bool> PIWire(wireID, value);
+
+    for (unsigned count = 0; count <= c.maxLevel; count++) {
+        if (c.isPI(PIWire.first)) return PIWire; // If the wire is a primary input
+
+        unsigned g = c.driverOf(PIWire.first);
+        if (g == NO_GATE) break; // The wire is neither a PI nor the output of a gate.
+
+        // Check if any of g's inputs are invalid (X) and use that input as the next wire ID. If the input value needed
+        // is the controlling value one input is enough, so take the easiest; otherwise all are needed, take the hardest.
+        bool inValue = PIWire.second ^ invParity(c.type[g]);
+        bool all = ((c.type[g] == INV) || (c.type[g] == BUF)) ? false : (inValue != cValue(c.type[g]));
+        unsigned int tempWire = xInput(g, inValue, all);
+        if (!tempWire) return PIWire; // This should never happen if the other functions work properly.
+        PIWire.first = tempWire; // use this "X line" to continue backtracing.
+        PIWire.second = inValue; // v = v xor i
     }
 
-    cout << "Backtrace could not converge quickly." << endl;
     return PIWire;
 }
 
 /*
  * Imply Pseudocode:
- * imply needs to update most global variables (errorAtPO, fLine, gateList, DFrontier, and testVector). Imply is
- * responsible for every value assignment (simulation) in the ckt and it "creates" the initial D/!D when a fault is
- * activated. Imply maintains the D-Frontier based on a 5-valued simulation (between 0, 1, x, D, and !D).
- * Inputs: PI wire and value to set the PI wire to.
- * Outputs: No outputs but changes several global variables.
- * When to stop: If the fault is propagated to a primary output or if it is no longer possible to do so.
+ * imply is responsible for every value assignment (simulation) in the ckt and it "creates" the initial D/!D when a
+ * fault is activated. The PI is set in both machines and its fanout gates are put in a levelized event queue. The
+ * queue is emptied level by level: each gate is evaluated in both machines (5-valued simulation between 0, 1, x, D,
+ * and !D) and, only if its output changed, the gates it fans out to are queued. Since a gate's inputs all come from
+ * lower levels, every gate is evaluated at most once per implication.
+ * Every value change and D-Frontier change is pushed on the trail, which is what rollback undoes on a backtrack.
+ * imply keeps fLine, the D-Frontier and the number of primary outputs with an error up to date.
  */
-void imply (unsigned int wireID, bool value, bool valid, const list<fault> &fList) {
-    unsigned int tfaultID = tFault.getFaultWire();
-    for (auto gate = gateList.begin(); gate != gateList.end(); gate++) {
-        if (valid) {
-            if (!gate->hasSimmed) {
-                if (gate->setInput(value, wireID)) { // Sets an input if it corresponds to the passed in wireID and returns true.
-                    if ((gate->isPInput(tfaultID)) && (wireID == tfaultID)) fLine = value; /// If that was a PI fault line that got set, update fLine.
-
-                    if (!gate->ready) { // Other input invalid
-                        if (!fList.empty() || (wireID == tfaultID)) DFrontier.push_back(gate->getAddr()); // Other input invalid plus fault on wire = DFrontier.
-                        else if (value == gate->cValue()) gate->ready = true; // No fault plus controlling value on input = ready to sim.
-                    }
-                    if (!fList.empty()) gate->setFaultList(wireID, fList); // Propagate list.
-                }
+void podemContext::imply (unsigned int wireID, bool value) {
+    TRACE(stats.implications++);
+    if (assignWire(wireID, value, value)) schedule(wireID);
+    propagate();
+}
 
-                // once every gate that is set ready and has not been simmed is simmed, imply will stop getting called.
-                if (gate->ready) {
-                    bool outVal = gate->simOutput(); // Gate simmed, detectable faults pushed to gate output.
-
-                    list<fault> gateFList = gate->getFaultList();
-                    if (!gateFList.empty()) {
-                        if (gateFList.front().getFault() != tFault.getFault()) {
-                            gateFList.clear();
-                            gate->setFaultList(gate->getOutputID(), gateFList);
-                        }
-                    }
-
-                    DFrontier.remove(gate->getAddr()); // Simulated gates in the DFrontier should be removed (If it's not in the DFrontier nothing happens).
-                    if (gate->getOutputID() == tfaultID) fLine = outVal; // If the gate that was simmed was the target fault then update fLine.
-
-                    if (gate->isOutGate) {
-                        if (!gate->getFaultList().empty()) {
-                            errorAtPO = true;
-                            cout << "Fault " << gate->getFaultList().front().getFaultWire() << " s-a-" <<
-                            gate->getFaultList().front().getFault() << " has propagated to the output!" << endl;
-                            return;
-                        }
-                    }
-                    /// BROADCAST THE SIMMED VALUE AND THE FAULT LIST USING A RECURSIVE CALL TO IMPLY.
-                    imply(gate->getOutputID(), outVal, valid, gate->getFaultList());
-                    if (errorAtPO) return;
-                }
-            }
+// Sets both machine values of a wire and records the old ones on the trail. Returns false if nothing changed.
+bool podemContext::assignWire (unsigned int wireID, int8_t gVal, int8_t fVal) {
+    if (wireID == faultWire) fVal = faultValue; // The faulty machine value of the fault line never changes.
+    if ((good[wireID] == gVal) && (faulty[wireID] == fVal)) return false;
+
+    if (c.isPO(wireID)) {
+        bool wasD = (good[wireID] >= 0) && (faulty[wireID] >= 0) && (good[wireID] != faulty[wireID]);
+        bool isD = (gVal >= 0) && (fVal >= 0) && (gVal != fVal);
+        if (isD && !wasD) dAtPO++;
+        else if (wasD && !isD) dAtPO--;
+    }
+
+    if (!need.empty() && need[wireID] >= 0) {
+        violated += (gVal == !need[wireID]);
+        violated -= (good[wireID] == !need[wireID]);
+    }
+
+    trail.push_back({wireID, good[wireID], faulty[wireID]});
+    good[wireID] = gVal;
+    faulty[wireID] = fVal;
+    if (xPath[wireID] && !isX(wireID)) xpWork.push_back(wireID); // Its X-path (and maybe its fanin's) is gone.
+    if (wireID == faultWire) fLine = gVal;
+    return true;
+}
+
+/// QUEUE THE FANOUT GATES OF A WIRE THAT CHANGED.
+void podemContext::schedule (unsigned int wireID) {
+    const unsigned* fo = c.fanout(wireID);
+    for (unsigned i = 0; i < c.numFanout(wireID); i++) {
+        unsigned g = fo[i];
+        if (queued[g]) continue;
+        queued[g] = true;
+        unsigned l = c.level[g];
+        eventQueue[l].push_back(g);
+        if (lowLevel > highLevel) lowLevel = highLevel = l; // The queue was empty.
+        else {
+            if (l < lowLevel) lowLevel = l;
+            if (l > highLevel) highLevel = l;
         }
+    }
+}
 
-        else { // Forward path-specific invalidation simulation
-            uint8_t gInval = gate->invalidateWire(wireID); // If the gate has an input wire with given wire ID, function invalidates the wire and returns 1, 2, or 3. Else it returns 0
-            if (gInval) {
-                if (wireID == tfaultID) {
-                    fLine = -1; // Just invalidated fault line (Should only happen if the fault can't be propagated)
-                    cout << "Fault line invalidated." << endl;
-                }
+void podemContext::propagate() {
+    for (unsigned l = lowLevel; l <= highLevel; l++) {
+        for (unsigned i = 0; i < eventQueue[l].size(); i++) {
+            unsigned g = eventQueue[l][i];
+            queued[g] = false;
+            TRACE(stats.gateEvals++);
+            if (assignWire(c.outWire[g], evalGate3(c, g, good), evalGate3(c, g, faulty))) schedule(c.outWire[g]);
+            updateDFrontier(g);
+        }
+        eventQueue[l].clear();
+    }
+    lowLevel = 1;
+    highLevel = 0; // Empty.
+    if (options.xPath) blockXPath();
+}
 
-                if (gInval > 1) { // Output was invalidated so need to propagate.
-                    // Other input had the fault, add to DFrontier
-                    if (gInval == 2) DFrontier.push_back(gate->getAddr());
+// X-path flags of the fanout cone of the fault site (the only wires an error can be on) for the values after the fault
+// injection, from the primary outputs back.
+void podemContext::initXPath() {
+    xpWork.clear();
+    xpTrail.clear();
+    if (!options.xPath) return;
+    for (auto w: coneWires) {
+        bool path = c.isPO(w);
+        const unsigned* fo = c.fanout(w);
+        for (unsigned i = 0; i < c.numFanout(w) && !path; i++) path = xPath[c.outWire[fo[i]]];
+        xPath[w] = path && isX(w);
+    }
+}
 
-                    // Other input did not have the fault, remove from DFrontier
-                    else if (gInval == 3) DFrontier.remove(gate->getAddr());
+// Clears the X-path of the wires in xpWork and then of every wire whose fanout has lost all its X-paths. Values only
+// go from X to known between backtracks, so flags are only cleared here.
+void podemContext::blockXPath() {
+    while (!xpWork.empty()) {
+        unsigned w = xpWork.back();
+        xpWork.pop_back();
+        if (!xPath[w]) continue;
+        if (isX(w)) {
+            if (c.isPO(w)) continue;
+            bool path = false;
+            const unsigned* fo = c.fanout(w);
+            for (unsigned i = 0; i < c.numFanout(w) && !path; i++) path = xPath[c.outWire[fo[i]]];
+            if (path) continue;
+        }
+        xPath[w] = false;
+        xpTrail.push_back(w);
+
+        unsigned d = c.driverOf(w);
+        if (d == NO_GATE) continue;
+        const unsigned* in = c.fanin(d);
+        for (unsigned i = 0; i < c.numFanin(d); i++) {
+            if (xPath[in[i]]) xpWork.push_back(in[i]);
+        }
+    }
+}
 
-                    // Propagate invalidation (gate->getFaultList() is empty because the output was invalidated).
-                    imply(gate->getOutputID(), false, false, gate->getFaultList());
-                }
-            }
+// The most observable D-Frontier gate whose output still has an X-path, or NO_GATE.
+unsigned podemContext::frontierGate() const {
+    for (auto &df: DFrontier) {
+        if (!options.xPath || xPath[c.outWire[df.second]]) return df.second;
+    }
+    return NO_GATE;
+}
+
+// A gate is in the D-Frontier if its output is still x and one of its inputs carries D or !D.
+void podemContext::updateDFrontier (unsigned g) {
+    unsigned o = c.outWire[g];
+    bool member = false;
+    if ((good[o] < 0) || (faulty[o] < 0)) {
+        const unsigned* in = c.fanin(g);
+        for (unsigned i = 0; i < c.numFanin(g) && !member; i++) {
+            member = (good[in[i]] >= 0) && (faulty[in[i]] >= 0) && (good[in[i]] != faulty[in[i]]);
         }
     }
+
+    if (member == (DFrontier.count(dfKey(g)) > 0)) return;
+    if (member) DFrontier.insert(dfKey(g));
+    else DFrontier.erase(dfKey(g));
+    dfTrail.push_back(g);
 }
 
+// Undoes every value, D-Frontier and X-path change made after the trails had the given sizes, newest first.
+void podemContext::rollback (size_t wireMark, size_t dfMark, size_t xpMark) {
+    while (trail.size() > wireMark) {
+        const trailEntry &t = trail.back();
+        if (c.isPO(t.wire)) {
+            bool isD = (good[t.wire] >= 0) && (faulty[t.wire] >= 0) && (good[t.wire] != faulty[t.wire]);
+            bool wasD = (t.good >= 0) && (t.faulty >= 0) && (t.good != t.faulty);
+            if (isD && !wasD) dAtPO--;
+            else if (wasD && !isD) dAtPO++;
+        }
+        if (!need.empty() && need[t.wire] >= 0) {
+            violated += (t.good == !need[t.wire]);
+            violated -= (good[t.wire] == !need[t.wire]);
+        }
+        good[t.wire] = t.good;
+        faulty[t.wire] = t.faulty;
+        if (t.wire == faultWire) fLine = t.good;
+        trail.pop_back();
+    }
+
+    while (dfTrail.size() > dfMark) {
+        unsigned g = dfTrail.back();
+        if (DFrontier.count(dfKey(g))) DFrontier.erase(dfKey(g));
+        else DFrontier.insert(dfKey(g));
+        dfTrail.pop_back();
+    }
+
+    while (xpTrail.size() > xpMark) {
+        xPath[xpTrail.back()] = true;
+        xpTrail.pop_back();
+    }
+}
+
+podemPool::podemPool (const circuit &c, unsigned numThreads, const podemOptions &options, const staticLearning *learned)
+    : pool(numThreads) {
+    // One context per worker thread, reused for every fault that the worker processes.
+    for (unsigned i = 0; i < pool.size(); i++) {
+        contexts.emplace_back(new podemContext(c, learned));
+        contexts.back()->options = options;
+        if (c.CO.empty()) contexts.back()->options.scoap = false; // The measures were not computed for this circuit.
+    }
+}
+
+podemResult podemPool::solve (unsigned worker, pair<unsigned int, bool> fault) {
+    podemContext &ctx = *contexts[worker];
+    podemResult r;
+    r.status = ctx.run(fault.first, fault.second);
+    r.backtracks = ctx.backtracks();
+    r.test = ctx.test();
+    TRACE(ctx.stats.worker = worker; podemTrace.record(ctx.stats));
+    return r;
+}
+
+vector<podemResult> podemPool::run (const vector<pair<unsigned int, bool>> &faults) {
+    vector<podemResult> results(faults.size());
+    pool.parallelFor(faults.size(), [&](unsigned i, unsigned worker) { results[i] = solve(worker, faults[i]); });
+    return results;
+}
+
+void podemPool::runQueue (const vector<pair<unsigned int, bool>> &faults, const function<int()> &next,
+                          const function<void(unsigned, podemResult&)> &done) {
+    // One loop per worker, each taking faults from the shared queue, so a hard fault only holds up its own thread.
+    pool.parallelFor(pool.size(), [&](unsigned, unsigned worker) {
+        for (int i = next(); i >= 0; i = next()) {
+            podemResult r = solve(worker, faults[i]);
+            done(i, r);
+        }
+    });
+}
+
+vector<podemResult> runPODEM (const circuit &c, const vector<pair<unsigned int, bool>> &faults, unsigned numThreads,
+                              const podemOptions &options, const staticLearning *learned) {
+    podemPool pool(c, numThreads, options, learned);
+    return pool.run(faults);
+}
@@ -0,0 +1,183 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ PODEM (Path Oriented Decision Making) test generation. All the state of one PODEM run (the 5-valued wire values, the
+ target fault, the D-Frontier and the test vector) lives in a podemContext, and the circuit is shared read-only, so
+ several contexts can generate tests for different faults at the same time. runPODEM spreads a fault list over a
+ work-stealing thread pool and returns the results in the order of the fault list.
+ The SCOAP measures of the circuit guide the search: objective picks the most observable D-Frontier gate and backtrace
+ follows the easiest input when one input is enough to set the objective and the hardest one when all inputs are needed.
+ Implication is event driven: only the gates whose inputs changed are evaluated, in level order, and every value change
+ is recorded on a trail so a backtrack rolls the circuit back to a decision without re-simulating anything.
+ The search is iterative (an explicit stack of PI decisions), so its depth is not limited by the call stack. Each fault
+ ends up detected, proven redundant (the whole decision space was exhausted) or aborted (the backtrack limit or the
+ time budget ran out).
+ An X-path check prunes the search early: a wire has an X-path if it is still X and is a primary output or drives a
+ gate whose output has one. Only the fanout cone of the fault site can carry the error, so only its wires are flagged.
+ The flags are cleared incrementally (backward from the wires that imply determines, and restored from a trail on a
+ backtrack), objective skips the D-Frontier gates whose output has no X-path, and the search backtracks as soon as no
+ D-Frontier gate (or, before excitation, not the fault site) has one.
+ With the static learning of the circuit (see learn.h), every fault starts with its mandatory assignments: the
+ excitation value and the non-controlling values on the side inputs of the dominators of the fault site, closed under
+ direct and learned implication. A conflict there proves the fault redundant without any search. During the search a
+ mandatory value that is contradicted is a conflict (backtrack at once) and one that is still X is the next objective;
+ while the D-Frontier is a single gate, the dominators of its output add side inputs the same way.
+*/
+
+#ifndef PODEM_H
+#define PODEM_H
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <vector>
+#include "Classes.h"
+#include "circuit.h"
+#include "cube.h"
+#include "learn.h"
+#include "threadpool.h"
+#include "trace.h"
+
+enum eFaultStatus {DETECTED, REDUNDANT, ABORTED};
+
+// Per fault effort limits (0 means no limit) and search heuristics.
+struct podemOptions {
+    unsigned backtracks = 100000;
+    double seconds = 0.0;
+    bool scoap = true; // Use the SCOAP measures of the circuit in objective and backtrace (else first X input).
+    bool xPath = true; // Backtrack when no D-Frontier gate has an X-path to a primary output.
+};
+
+class podemContext {
+public:
+    // learned (if given) must have been built for the same circuit.
+    explicit podemContext (const circuit &cRef, const staticLearning *learned = nullptr);
+
+    // Generates a test for wireID s-a-sa. If the fault is detected, the test is then available from test().
+    eFaultStatus run (unsigned wireID, bool sa);
+    // Same, but the PIs that are specified in cube keep their values. REDUNDANT then only means that no test agrees
+    // with the cube.
+    eFaultStatus run (unsigned wireID, bool sa, const testCube &cube);
+
+    // The PI values of the test (in inWires order), X for the PIs it leaves open.
+    const testCube &test() const { return testVector; }
+    unsigned backtracks() const { return numBacktracks; } // Backtracks used by the last run.
+
+    podemOptions options;
+    TRACE(faultCounters stats;) // Counters of the last run (only with PODEM_TRACE).
+
+private:
+    eFaultStatus PODEM();
+    pair<unsigned int, bool> objective();
+    bool mandatory (pair<unsigned int, bool> &goal);
+    bool sideInputs (unsigned domWire, pair<unsigned int, bool> &goal);
+    bool mandatorySetup (const testCube &cube);
+    pair<unsigned int, bool> backtrace (unsigned int wireID, bool value);
+    void imply (unsigned int wireID, bool value);
+    bool assignWire (unsigned int wireID, int8_t gVal, int8_t fVal);
+    void schedule (unsigned int wireID);
+    void propagate();
+    void faultCone();
+    void initXPath();
+    void blockXPath();
+    unsigned frontierGate() const;
+    bool isX (unsigned wireID) const { return (good[wireID] < 0) || (faulty[wireID] < 0); }
+    void updateDFrontier (unsigned g);
+    void rollback (size_t wireMark, size_t dfMark, size_t xpMark);
+    unsigned xInput (unsigned g, bool value, bool hardest) const;
+    pair<unsigned, unsigned> dfKey (unsigned g) const;
+
+    const circuit &c;
+    const staticLearning *learning;
+    implicationEngine engine;
+
+    // Per fault state. Every wire has a good machine and a faulty machine value (0, 1 or -1 for X); a wire whose two
+    // values are known and differ carries D (1/0) or !D (0/1).
+    vector<int8_t> good;
+    vector<int8_t> faulty;
+    unsigned faultWire = 0;
+    bool faultValue = false;
+    int8_t fLine = -1; // Good value of the fault line. If l has value v, l s-a-v is undetectable.
+    unsigned dAtPO = 0; // Number of primary outputs that carry D or !D.
+    set<pair<unsigned, unsigned>> DFrontier; // (CO of the gate output, gate), so the most observable gate comes first.
+    unsigned dGate = NO_GATE; // The first D-Frontier gate with an X-path, the target of objective.
+    testCube testVector;
+    unsigned numBacktracks = 0;
+
+    // Fanout cone of the fault site.
+    vector<bool> inCone;
+    vector<unsigned> coneWires;
+
+    // Mandatory assignments of the fault (good machine values). need is the
+    // mandatory value of every wire (-1 for none), violated counts the wires that have the opposite value and the
+    // mandatory assignments before nextRequired are known to be set.
+    vector<pair<unsigned, bool>> required;
+    vector<int8_t> need;
+    unsigned violated = 0;
+    size_t nextRequired = 0;
+
+    // Decision stack. Each entry is a PI assignment and the trail sizes to roll back to when it is undone.
+    struct decision {
+        unsigned wire;
+        bool value;
+        bool flipped; // Both values of the PI have been tried once this is true.
+        size_t wireMark, dfMark, xpMark, reqMark;
+    };
+    vector<decision> decisions;
+
+    // Undo trail. A backtrack pops the wire values and D-Frontier changes made since the decision was taken.
+    struct trailEntry {
+        unsigned wire;
+        int8_t good, faulty; // Values before the change.
+    };
+    vector<trailEntry> trail;
+    vector<unsigned> dfTrail; // Gates whose D-Frontier membership was flipped.
+
+    // X-path flags per wire. xpTrail holds the wires whose flag was cleared, xpWork the wires to check.
+    vector<bool> xPath;
+    vector<unsigned> xpTrail, xpWork;
+
+    // Levelized event queue: gates whose inputs changed, bucketed by level.
+    vector<vector<unsigned>> eventQueue;
+    vector<bool> queued;
+    unsigned lowLevel = 1, highLevel = 0; // Range of levels that may hold events (empty while lowLevel > highLevel).
+};
+
+struct podemResult {
+    eFaultStatus status = ABORTED;
+    unsigned backtracks = 0;
+    testCube test;
+};
+
+// PODEM contexts on a thread pool that are kept between calls, for callers that feed it faults as they go.
+class podemPool {
+public:
+    podemPool (const circuit &c, unsigned numThreads, const podemOptions &options,
+               const staticLearning *learned = nullptr);
+
+    // results[i] belongs to faults[i] whatever the thread count.
+    vector<podemResult> run (const vector<pair<unsigned int, bool>> &faults);
+
+    // Every worker asks next() for the index (into faults) of its next target until it returns -1, and hands each
+    // result to done(i, result) as soon as PODEM returns it. Both are called from the worker threads, so they have to
+    // lock what they share. With one thread the faults are processed strictly one after the other.
+    void runQueue (const vector<pair<unsigned int, bool>> &faults, const function<int()> &next,
+                   const function<void(unsigned, podemResult&)> &done);
+    unsigned size() const { return pool.size(); }
+
+private:
+    podemResult solve (unsigned worker, pair<unsigned int, bool> fault);
+
+    threadPool pool;
+    vector<unique_ptr<podemContext>> contexts;
+};
+
+// Runs PODEM for every fault on numThreads threads. results[i] belongs to faults[i] whatever the thread count. The
+// search uses the mandatory assignments when learned is given.
+vector<podemResult> runPODEM (const circuit &c, const vector<pair<unsigned int, bool>> &faults, unsigned numThreads,
+                              const podemOptions &options, const staticLearning *learned = nullptr);
+
+#endif
@@ -0,0 +1,71 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ PPSFP fault simulator (see ppsfp.h).
+*/
+
+#include "ppsfp.h"
+#include "psim.h"
+
+ppsfp::ppsfp (const circuit &cRef) : c(cRef) {
+    good.assign(c.numWires(), 0);
+    faulty.assign(c.numWires(), 0);
+    levelQueue.resize(c.maxLevel + 1);
+    queued.assign(c.numGates(), false);
+}
+
+void ppsfp::goodSim (const vector<uint64_t> &piWords) {
+    simBlock(c, piWords, good);
+    faulty = good;
+}
+
+uint64_t ppsfp::detect (unsigned wireID, bool sa, uint64_t mask) {
+    uint64_t stuck = sa ? ~0ULL : 0;
+    uint64_t diff = (good[wireID] ^ stuck) & mask;
+    if (!diff) return 0; // The fault is not excited by any vector of the block.
+
+    uint64_t detected = c.isPO(wireID) ? diff : 0;
+    faulty[wireID] = stuck;
+    touched.push_back(wireID);
+
+    // Schedule the fanout of the fault site, then sweep the levels upward. The circuit is acyclic so a gate is never
+    // scheduled again after it has been evaluated.
+    unsigned low = c.maxLevel + 1, high = 0;
+    auto schedule = [&](unsigned w) {
+        const unsigned* fo = c.fanout(w);
+        for (unsigned i = 0; i < c.numFanout(w); i++) {
+            unsigned g = fo[i];
+            if (queued[g]) continue;
+            queued[g] = true;
+            unsigned l = c.level[g];
+            levelQueue[l].push_back(g);
+            if (l < low) low = l;
+            if (l > high) high = l;
+        }
+    };
+    schedule(wireID);
+
+    for (unsigned l = low; l <= high && l <= c.maxLevel; l++) {
+        for (unsigned i = 0; i < levelQueue[l].size(); i++) {
+            unsigned g = levelQueue[l][i];
+            queued[g] = false;
+            unsigned out = c.outWire[g];
+            uint64_t v = evalGate(c, g, faulty.data());
+            if (v == faulty[out]) continue; // The difference died at this gate.
+
+            faulty[out] = v;
+            touched.push_back(out);
+            if (c.isPO(out)) detected |= (v ^ good[out]) & mask;
+            schedule(out);
+        }
+        levelQueue[l].clear();
+    }
+
+    // Restore the faulty machine to the good machine for the next fault.
+    for (unsigned w : touched) faulty[w] = good[w];
+    touched.clear();
+    return detected;
+}
@@ -0,0 +1,43 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel-pattern single-fault propagation (PPSFP) fault simulator. The good machine is simulated once per block of 64
+ vectors with the bit-parallel simulator, then every fault is injected on its own and only the difference from the
+ fault site is propagated, event driven and in level order, through the fanout cone of the fault. A fault is detected
+ by vector k of the block if bit k differs between the good and the faulty machine on some primary output.
+ This is an alternative to the deductive simulator in applyInput that does not carry a fault list on every gate.
+*/
+
+#ifndef PPSFP_H
+#define PPSFP_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+
+class ppsfp {
+public:
+    explicit ppsfp (const circuit &cRef);
+
+    // Simulates the good machine for one block of (up to 64) vectors packed one word per PI.
+    void goodSim (const vector<uint64_t> &piWords);
+
+    // Returns the vectors of the current block (as bits of a word) that detect wireID s-a-sa. Only the bits set in
+    // mask (the valid vectors of the block) are considered.
+    uint64_t detect (unsigned wireID, bool sa, uint64_t mask);
+
+    const vector<uint64_t> &goodValues() const { return good; }
+
+private:
+    const circuit &c;
+    vector<uint64_t> good; // Good machine value of every wire.
+    vector<uint64_t> faulty; // Faulty machine value of every wire (equal to good outside the fault's cone).
+    vector<unsigned> touched; // Wires whose faulty value was changed by the current fault.
+    vector<vector<unsigned>> levelQueue; // Gates scheduled for evaluation, bucketed by level.
+    vector<bool> queued;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Parallel-pattern good machine simulator (see psim.h).
+*/
+
+#include "psim.h"
+
+void packVectors (const vector<vector<bool>> &vecs, unsigned first, unsigned count, vector<uint64_t> &piWords) {
+    unsigned numIn = vecs.empty() ? 0 : vecs[first].size();
+    piWords.assign(numIn, 0);
+    for (unsigned k = 0; k < count; k++) {
+        const vector<bool> &v = vecs[first + k];
+        for (unsigned i = 0; i < numIn; i++) {
+            if (v[i]) piWords[i] |= (1ULL << k);
+        }
+    }
+}
+
+void unpackVectors (const vector<uint64_t> &piWords, unsigned count, vector<vector<bool>> &vecs) {
+    for (unsigned k = 0; k < count; k++) {
+        vector<bool> v(piWords.size());
+        for (unsigned i = 0; i < piWords.size(); i++) v[i] = (piWords[i] >> k) & 1;
+        vecs.push_back(v);
+    }
+}
+
+void simBlock (const circuit &c, const vector<uint64_t> &piWords, vector<uint64_t> &val) {
+    for (unsigned i = 0; i < c.PIs.size() && i < piWords.size(); i++) val[c.PIs[i]] = piWords[i];
+
+    // order[] is topological, so every input word is final by the time a gate is evaluated.
+    for (unsigned g : c.order) val[c.outWire[g]] = evalGate(c, g, val.data());
+}
+
+vector<vector<bool>> simVectors (const circuit &c, const vector<vector<bool>> &vecs) {
+    vector<vector<bool>> outVals(vecs.size(), vector<bool>(c.POs.size()));
+    vector<uint64_t> piWords;
+    vector<uint64_t> val(c.numWires(), 0);
+
+    for (unsigned first = 0; first < vecs.size(); first += BLOCK_SIZE) {
+        unsigned count = (vecs.size() - first < BLOCK_SIZE) ? vecs.size() - first : BLOCK_SIZE;
+        packVectors(vecs, first, count, piWords);
+        simBlock(c, piWords, val);
+
+        for (unsigned o = 0; o < c.POs.size(); o++) {
+            uint64_t w = val[c.POs[o]];
+            for (unsigned k = 0; k < count; k++) outVals[first + k][o] = (w >> k) & 1;
+        }
+    }
+    return outVals;
+}
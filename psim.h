@@ -0,0 +1,56 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Bit-parallel (parallel-pattern) logic simulation of the levelized circuit. Up to 64 test vectors are packed into one
+ machine word per wire (bit k of every word belongs to the k-th vector of the block) and every gate is evaluated once
+ per word in level order, so a block of 64 vectors costs the same as a single vector in applyInput.
+*/
+
+#ifndef PSIM_H
+#define PSIM_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+
+const unsigned BLOCK_SIZE = 64; // Vectors per pattern word.
+
+// Evaluates gate g of c from the pattern words of its input wires.
+inline uint64_t evalGate (const circuit &c, unsigned g, const uint64_t* val) {
+    const unsigned* in = c.fanin(g);
+    unsigned n = c.numFanin(g);
+    uint64_t r;
+    switch (c.type[g]) {
+        case AND:
+        case NAND:
+            r = ~0ULL;
+            for (unsigned i = 0; i < n; i++) r &= val[in[i]];
+            return (c.type[g] == NAND) ? ~r : r;
+        case OR:
+        case NOR:
+            r = 0;
+            for (unsigned i = 0; i < n; i++) r |= val[in[i]];
+            return (c.type[g] == NOR) ? ~r : r;
+        case INV:
+            return ~val[in[0]];
+        default: // BUF
+            return val[in[0]];
+    }
+}
+
+// Packs vecs[first] .. vecs[first+count-1] (count <= 64) into one word per primary input, in inWires order.
+void packVectors (const vector<vector<bool>> &vecs, unsigned first, unsigned count, vector<uint64_t> &piWords);
+
+// The reverse of packVectors: appends the count vectors held in piWords to vecs.
+void unpackVectors (const vector<uint64_t> &piWords, unsigned count, vector<vector<bool>> &vecs);
+
+// Simulates one block. val must hold c.numWires() words and receives the value of every wire.
+void simBlock (const circuit &c, const vector<uint64_t> &piWords, vector<uint64_t> &val);
+
+// Simulates every vector and returns the primary output values of each one (in the order of c.POs).
+vector<vector<bool>> simVectors (const circuit &c, const vector<vector<bool>> &vecs);
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Random pattern generator and random pattern fault simulation phase (see randpat.h).
+*/
+
+#include "randpat.h"
+#include "ppsfp.h"
+#include "psim.h"
+
+static uint64_t rotl (uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+void patternRng::reseed (uint64_t seed) {
+    // splitmix64 spreads any seed (including 0) over the whole state.
+    for (auto &w: s) {
+        seed += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = seed;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        w = z ^ (z >> 31);
+    }
+}
+
+uint64_t patternRng::next() {
+    uint64_t r = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return r;
+}
+
+void patternRng::fill (vector<uint64_t> &piWords, unsigned numIn) {
+    piWords.resize(numIn);
+    for (auto &w: piWords) w = next();
+}
+
+randomPhaseResult randomPhase (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                               const randomPhaseOptions &options) {
+    randomPhaseResult res;
+    res.detectedBy.assign(faults.size(), -1);
+    patternRng rng(options.seed);
+    ppsfp sim(c);
+    vector<uint64_t> piWords;
+    vector<unsigned> live; // Faults that are still undetected.
+    for (unsigned f = 0; f < faults.size(); f++) live.push_back(f);
+    unsigned lastDetection = 0; // Number of vectors simulated up to the last one that detected a new fault.
+
+    while (!live.empty() && res.simulated < options.maxVectors && res.simulated - lastDetection < options.window) {
+        rng.fill(piWords, c.PIs.size());
+        sim.goodSim(piWords);
+
+        // Fault dropping: only the faults that are still undetected are simulated. Vector k of the block is kept if
+        // it is the first vector to detect some fault (bit k of useful).
+        uint64_t useful = 0;
+        vector<unsigned> newDet;
+        unsigned kept = 0;
+        for (unsigned i = 0; i < live.size(); i++) {
+            unsigned f = live[i];
+            uint64_t d = sim.detect(faults[f].first, faults[f].second, ~0ULL);
+            if (!d) live[kept++] = f;
+            else {
+                useful |= d & -d;
+                res.detectedBy[f] = __builtin_ctzll(d); // Position in the block for now.
+                newDet.push_back(f);
+            }
+        }
+        live.resize(kept);
+
+        if (useful) {
+            vector<vector<bool>> block;
+            unpackVectors(piWords, BLOCK_SIZE, block);
+            int index[BLOCK_SIZE];
+            for (unsigned k = 0; k < BLOCK_SIZE; k++) {
+                if (!((useful >> k) & 1)) continue;
+                index[k] = res.vectors.size();
+                res.vectors.push_back(block[k]);
+            }
+            for (unsigned f: newDet) res.detectedBy[f] = index[res.detectedBy[f]];
+            res.detected += newDet.size();
+            lastDetection = res.simulated + BLOCK_SIZE - __builtin_clzll(useful);
+        }
+        res.simulated += BLOCK_SIZE;
+    }
+    return res;
+}
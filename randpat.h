@@ -0,0 +1,52 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Random pattern phase that runs ahead of deterministic test generation. A seeded xoshiro256** generator produces the
+ primary input words of 64 random vectors at a time, which go straight into the PPSFP fault simulator with fault
+ dropping. Random patterns quickly detect the easy faults; once a configurable number of vectors in a row detects no
+ new fault the coverage has saturated, the phase stops and only the faults that are still undetected are left to PODEM.
+ The same seed always produces the same vectors.
+*/
+
+#ifndef RANDPAT_H
+#define RANDPAT_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+
+// xoshiro256** pseudo random generator, seeded through splitmix64.
+class patternRng {
+public:
+    explicit patternRng (uint64_t seed = 1) { reseed(seed); }
+    void reseed (uint64_t seed);
+    uint64_t next();
+
+    // One random word per primary input, i.e. a block of 64 random vectors.
+    void fill (vector<uint64_t> &piWords, unsigned numIn);
+
+private:
+    uint64_t s[4];
+};
+
+struct randomPhaseOptions {
+    uint64_t seed = 1;
+    unsigned window = 2048; // Stop after this many vectors in a row without a new detection.
+    unsigned maxVectors = 1000000;
+};
+
+struct randomPhaseResult {
+    vector<vector<bool>> vectors; // The random vectors that were the first to detect some fault, in order.
+    vector<int> detectedBy; // Per fault, the index in vectors of the vector that detected it first (-1 if none).
+    unsigned simulated = 0; // Random vectors simulated before the phase stopped (a multiple of 64).
+    unsigned detected = 0;
+};
+
+// Fault simulates random vectors against faults until the coverage saturates.
+randomPhaseResult randomPhase (const circuit &c, const vector<pair<unsigned int, bool>> &faults,
+                               const randomPhaseOptions &options);
+
+#endif
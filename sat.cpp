@@ -0,0 +1,311 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ CDCL SAT solver (see sat.h).
+*/
+
+#include <algorithm>
+#include "sat.h"
+
+const double VAR_DECAY = 0.95;
+const uint64_t RESTART_UNIT = 100; // Conflicts per unit of the Luby restart sequence.
+
+// Luby sequence 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8 ..
+static uint64_t luby (uint64_t i) {
+    uint64_t size = 1, seq = 0;
+    while (size < i + 1) {
+        seq++;
+        size = 2 * size + 1;
+    }
+    uint64_t x = i;
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+    return 1ULL << seq;
+}
+
+void satSolver::clear() {
+    clauses.clear();
+    watches.clear();
+    assigns.clear();
+    polarity.clear();
+    level.clear();
+    reason.clear();
+    trail.clear();
+    trailLim.clear();
+    qhead = 0;
+    activity.clear();
+    varInc = 1.0;
+    heap.clear();
+    heapIndex.clear();
+    seen.clear();
+    numConflicts = 0;
+    ok = true;
+}
+
+unsigned satSolver::newVar() {
+    unsigned v = assigns.size();
+    assigns.push_back(-1);
+    polarity.push_back(1); // Negative phase first.
+    level.push_back(0);
+    reason.push_back(-1);
+    activity.push_back(0.0);
+    heapIndex.push_back(-1);
+    seen.push_back(0);
+    watches.emplace_back();
+    watches.emplace_back();
+    heapInsert(v);
+    return v;
+}
+
+void satSolver::enqueue (int l, int from) {
+    unsigned v = l >> 1;
+    assigns[v] = !(l & 1);
+    level[v] = decisionLevel();
+    reason[v] = from;
+    trail.push_back(l);
+}
+
+void satSolver::attach (int ci) {
+    watches[clauses[ci][0]].push_back(ci);
+    watches[clauses[ci][1]].push_back(ci);
+}
+
+void satSolver::addClause (vector<int> lits) {
+    if (!ok) return;
+    sort(lits.begin(), lits.end());
+    lits.erase(unique(lits.begin(), lits.end()), lits.end());
+    unsigned kept = 0;
+    for (unsigned i = 0; i < lits.size(); i++) {
+        if (i + 1 < lits.size() && lits[i + 1] == (lits[i] ^ 1)) return; // x or not x.
+        int8_t val = litValue(lits[i]);
+        if (val == 1) return; // Already satisfied at level 0.
+        if (val < 0) lits[kept++] = lits[i];
+    }
+    lits.resize(kept);
+
+    if (lits.empty()) ok = false;
+    else if (lits.size() == 1) {
+        enqueue(lits[0], -1);
+        ok = (propagate() < 0);
+    }
+    else {
+        clauses.push_back(lits);
+        attach(clauses.size() - 1);
+    }
+}
+
+int satSolver::propagate() {
+    while (qhead < trail.size()) {
+        int falseLit = trail[qhead++] ^ 1;
+        vector<int> &ws = watches[falseLit];
+        size_t i = 0, j = 0;
+        while (i < ws.size()) {
+            int ci = ws[i++];
+            vector<int> &c = clauses[ci];
+            if (c[0] == falseLit) swap(c[0], c[1]);
+            if (litValue(c[0]) == 1) {
+                ws[j++] = ci;
+                continue;
+            }
+
+            // Look for a new literal to watch.
+            bool moved = false;
+            for (size_t k = 2; k < c.size(); k++) {
+                if (litValue(c[k]) != 0) {
+                    swap(c[1], c[k]);
+                    watches[c[1]].push_back(ci);
+                    moved = true;
+                    break;
+                }
+            }
+            if (moved) continue;
+
+            ws[j++] = ci;
+            if (litValue(c[0]) == 0) { // Conflict.
+                while (i < ws.size()) ws[j++] = ws[i++];
+                ws.resize(j);
+                qhead = trail.size();
+                return ci;
+            }
+            enqueue(c[0], ci);
+        }
+        ws.resize(j);
+    }
+    return -1;
+}
+
+// A literal of the learnt clause can be left out if its reason only has literals that are already in the clause.
+bool satSolver::redundantLit (int l) const {
+    int r = reason[l >> 1];
+    if (r < 0) return false;
+    for (size_t k = 1; k < clauses[r].size(); k++) {
+        unsigned v = clauses[r][k] >> 1;
+        if (!seen[v] && level[v] > 0) return false;
+    }
+    return true;
+}
+
+void satSolver::analyze (int confl, vector<int> &learnt, unsigned &backLevel) {
+    learnt.assign(1, 0);
+    int pathCount = 0, p = -1;
+    size_t index = trail.size();
+    toClear.clear();
+
+    do {
+        const vector<int> &c = clauses[confl];
+        for (size_t j = (p < 0) ? 0 : 1; j < c.size(); j++) {
+            unsigned v = c[j] >> 1;
+            if (seen[v] || level[v] == 0) continue;
+            bump(v);
+            seen[v] = 1;
+            toClear.push_back(v);
+            if (level[v] >= decisionLevel()) pathCount++;
+            else learnt.push_back(c[j]);
+        }
+        while (!seen[trail[--index] >> 1]) {}
+        p = trail[index];
+        confl = reason[p >> 1];
+        seen[p >> 1] = 0;
+        pathCount--;
+    } while (pathCount > 0);
+    learnt[0] = p ^ 1;
+
+    unsigned kept = 1;
+    for (size_t i = 1; i < learnt.size(); i++) {
+        if (!redundantLit(learnt[i])) learnt[kept++] = learnt[i];
+    }
+    learnt.resize(kept);
+    for (auto v: toClear) seen[v] = 0;
+
+    // The literal with the highest level after the asserting one is watched, and the solver backtracks to its level.
+    backLevel = 0;
+    for (size_t i = 1; i < learnt.size(); i++) {
+        if (level[learnt[i] >> 1] > backLevel) {
+            backLevel = level[learnt[i] >> 1];
+            swap(learnt[1], learnt[i]);
+        }
+    }
+}
+
+void satSolver::backtrack (unsigned toLevel) {
+    if (decisionLevel() <= toLevel) return;
+    for (size_t i = trail.size(); i > trailLim[toLevel]; i--) {
+        unsigned v = trail[i - 1] >> 1;
+        polarity[v] = trail[i - 1] & 1;
+        assigns[v] = -1;
+        reason[v] = -1;
+        if (heapIndex[v] < 0) heapInsert(v);
+    }
+    trail.resize(trailLim[toLevel]);
+    trailLim.resize(toLevel);
+    qhead = trail.size();
+}
+
+int satSolver::pickBranchLit() {
+    while (!heap.empty()) {
+        unsigned v = heapPop();
+        if (assigns[v] < 0) return 2 * v + polarity[v];
+    }
+    return -1;
+}
+
+void satSolver::bump (unsigned v) {
+    activity[v] += varInc;
+    if (activity[v] > 1e100) { // Rescale everything before the activities overflow.
+        for (auto &a: activity) a *= 1e-100;
+        varInc *= 1e-100;
+    }
+    if (heapIndex[v] >= 0) heapUp(heapIndex[v]);
+}
+
+void satSolver::heapInsert (unsigned v) {
+    heapIndex[v] = heap.size();
+    heap.push_back(v);
+    heapUp(heap.size() - 1);
+}
+
+unsigned satSolver::heapPop() {
+    unsigned top = heap[0];
+    heap[0] = heap.back();
+    heapIndex[heap[0]] = 0;
+    heap.pop_back();
+    heapIndex[top] = -1;
+    if (!heap.empty()) heapDown(0);
+    return top;
+}
+
+void satSolver::heapUp (unsigned i) {
+    unsigned v = heap[i];
+    while (i > 0 && activity[heap[(i - 1) / 2]] < activity[v]) {
+        heap[i] = heap[(i - 1) / 2];
+        heapIndex[heap[i]] = i;
+        i = (i - 1) / 2;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+void satSolver::heapDown (unsigned i) {
+    unsigned v = heap[i];
+    while (2 * i + 1 < heap.size()) {
+        unsigned child = 2 * i + 1;
+        if (child + 1 < heap.size() && activity[heap[child + 1]] > activity[heap[child]]) child++;
+        if (activity[heap[child]] <= activity[v]) break;
+        heap[i] = heap[child];
+        heapIndex[heap[i]] = i;
+        i = child;
+    }
+    heap[i] = v;
+    heapIndex[v] = i;
+}
+
+eSatResult satSolver::solve (uint64_t conflictLimit) {
+    if (!ok || propagate() >= 0) return SAT_FALSE;
+
+    vector<int> learnt;
+    uint64_t restarts = 0, restartConflicts = 0, start = numConflicts;
+    while (true) {
+        int confl = propagate();
+        if (confl >= 0) {
+            numConflicts++;
+            restartConflicts++;
+            if (decisionLevel() == 0) {
+                ok = false;
+                return SAT_FALSE;
+            }
+
+            unsigned backLevel;
+            analyze(confl, learnt, backLevel);
+            backtrack(backLevel);
+            if (learnt.size() == 1) enqueue(learnt[0], -1);
+            else {
+                clauses.push_back(learnt);
+                attach(clauses.size() - 1);
+                enqueue(learnt[0], clauses.size() - 1);
+            }
+            varInc /= VAR_DECAY;
+
+            if (conflictLimit && numConflicts - start >= conflictLimit) {
+                backtrack(0);
+                return SAT_UNKNOWN;
+            }
+            if (restartConflicts >= luby(restarts) * RESTART_UNIT) {
+                restarts++;
+                restartConflicts = 0;
+                backtrack(0);
+            }
+        }
+        else {
+            int l = pickBranchLit();
+            if (l < 0) return SAT_TRUE; // Every variable is assigned, assigns is the model.
+            trailLim.push_back(trail.size());
+            enqueue(l, -1);
+        }
+    }
+}
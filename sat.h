@@ -0,0 +1,77 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Small CDCL SAT solver for the SAT based test generator (see satatpg.h). Conflict driven clause learning with first UIP
+ learnt clauses, two watched literals per clause, VSIDS variable activities kept in a binary heap, phase saving and Luby
+ restarts. It has no preprocessing and never deletes learnt clauses, which is fine for the one-fault miters it solves:
+ every solve is bounded by a conflict limit and the solver is cleared for the next fault.
+ A literal is 2*v for variable v and 2*v+1 for its negation.
+*/
+
+#ifndef SAT_H
+#define SAT_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+enum eSatResult {SAT_TRUE, SAT_FALSE, SAT_UNKNOWN};
+
+inline int posLit (unsigned v) { return 2 * v; }
+inline int negLit (unsigned v) { return 2 * v + 1; }
+
+class satSolver {
+public:
+    void clear(); // Removes every variable and clause (keeps the allocations).
+    unsigned newVar();
+    unsigned numVars() const { return assigns.size(); }
+
+    // Adds a clause before solve is called. A clause that is false at level 0 makes the problem unsatisfiable.
+    void addClause (vector<int> lits);
+
+    // Stops with SAT_UNKNOWN after conflictLimit conflicts (0 means no limit).
+    eSatResult solve (uint64_t conflictLimit);
+    bool modelValue (unsigned v) const { return assigns[v] == 1; } // After SAT_TRUE.
+    uint64_t conflicts() const { return numConflicts; }
+
+private:
+    int8_t litValue (int l) const { return (assigns[l >> 1] < 0) ? -1 : assigns[l >> 1] ^ (l & 1); }
+    unsigned decisionLevel() const { return trailLim.size(); }
+    void enqueue (int l, int from);
+    int propagate(); // Returns the conflicting clause or -1.
+    void analyze (int confl, vector<int> &learnt, unsigned &backLevel);
+    bool redundantLit (int l) const;
+    void backtrack (unsigned toLevel);
+    int pickBranchLit();
+    void bump (unsigned v);
+    void attach (int ci);
+
+    // Activity heap.
+    void heapInsert (unsigned v);
+    unsigned heapPop();
+    void heapUp (unsigned i);
+    void heapDown (unsigned i);
+
+    vector<vector<int>> clauses; // The first two literals of a clause are its watches.
+    vector<vector<int>> watches; // Clauses that watch each literal.
+    vector<int8_t> assigns, polarity; // Value of every variable (-1 unassigned) and its saved phase.
+    vector<unsigned> level;
+    vector<int> reason; // Clause that implied the variable, -1 for decisions and level 0 units.
+    vector<int> trail;
+    vector<unsigned> trailLim;
+    size_t qhead = 0;
+    vector<double> activity;
+    double varInc = 1.0;
+    vector<unsigned> heap;
+    vector<int> heapIndex; // Position of every variable in heap, or -1.
+    vector<char> seen;
+    vector<int> toClear;
+    uint64_t numConflicts = 0;
+    bool ok = true;
+};
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Miter construction for one fault and the fallback driver for the faults that PODEM aborted (see satatpg.h).
+*/
+
+#include <memory>
+#include "satatpg.h"
+#include "threadpool.h"
+
+satATPG::satATPG (const circuit &cRef) : c(cRef) {
+    goodVar.assign(c.numWires(), -1);
+    faultyVar.assign(c.numWires(), -1);
+    diffVar.assign(c.numWires(), -1);
+    inFanout.assign(c.numWires(), false);
+}
+
+int satATPG::faultyLit (unsigned wireID) const {
+    if (wireID == faultWire) return faultValue ? posLit(constVar) : negLit(constVar);
+    return (faultyVar[wireID] >= 0) ? posLit(faultyVar[wireID]) : goodLit(wireID);
+}
+
+// Tseitin clauses of gate g over the good literals, or over the faulty literals for the faulty copy.
+void satATPG::encodeGate (unsigned g, bool faultyCopy) {
+    unsigned o = c.outWire[g];
+    const unsigned* in = c.fanin(g);
+    unsigned n = c.numFanin(g);
+    auto lit = [&](unsigned w) { return faultyCopy ? faultyLit(w) : goodLit(w); };
+    int z = lit(o);
+
+    switch (c.type[g]) {
+        case INV:
+        case BUF: {
+            int x = lit(in[0]) ^ (c.type[g] == INV);
+            solver.addClause({z, x ^ 1});
+            solver.addClause({z ^ 1, x});
+            break;
+        }
+        default: {
+            // AND/NAND: z' = x1 & .. & xn. OR/NOR are the same with every literal negated.
+            bool orType = (c.type[g] == OR) || (c.type[g] == NOR);
+            bool inverted = (c.type[g] == NAND) || (c.type[g] == NOR);
+            int zAnd = z ^ inverted ^ orType;
+            lits.assign(1, zAnd);
+            for (unsigned i = 0; i < n; i++) {
+                int x = lit(in[i]) ^ orType;
+                solver.addClause({zAnd ^ 1, x});
+                lits.push_back(x ^ 1);
+            }
+            solver.addClause(lits);
+        }
+    }
+}
+
+eFaultStatus satATPG::run (unsigned wireID, bool sa, const satOptions &options) {
+    for (auto w: used) {
+        goodVar[w] = faultyVar[w] = diffVar[w] = -1;
+        inFanout[w] = false;
+    }
+    used.clear();
+    solver.clear();
+    testVector.reset(c.PIs.size());
+    if (wireID >= c.numWires()) return ABORTED;
+    faultWire = wireID;
+    faultValue = sa;
+
+    // Fanout cone of the fault site and the primary outputs in it.
+    vector<unsigned> roots;
+    stack.assign(1, wireID);
+    inFanout[wireID] = true;
+    used.push_back(wireID);
+    while (!stack.empty()) {
+        unsigned x = stack.back();
+        stack.pop_back();
+        if (c.isPO(x)) roots.push_back(x);
+        const unsigned* fo = c.fanout(x);
+        for (unsigned i = 0; i < c.numFanout(x); i++) {
+            unsigned o = c.outWire[fo[i]];
+            if (inFanout[o]) continue;
+            inFanout[o] = true;
+            used.push_back(o);
+            stack.push_back(o);
+        }
+    }
+    if (roots.empty()) return REDUNDANT; // No primary output can observe the fault.
+
+    // Good circuit: the fanin cone of those outputs.
+    vector<unsigned> cone;
+    for (auto r: roots) {
+        if (goodVar[r] >= 0) continue;
+        goodVar[r] = solver.newVar();
+        stack.assign(1, r);
+        while (!stack.empty()) {
+            unsigned x = stack.back();
+            stack.pop_back();
+            cone.push_back(x);
+            unsigned d = c.driverOf(x);
+            if (d == NO_GATE) continue;
+            const unsigned* in = c.fanin(d);
+            for (unsigned i = 0; i < c.numFanin(d); i++) {
+                if (goodVar[in[i]] >= 0) continue;
+                goodVar[in[i]] = solver.newVar();
+                used.push_back(in[i]);
+                stack.push_back(in[i]);
+            }
+        }
+        used.push_back(r);
+    }
+    constVar = solver.newVar();
+    solver.addClause({posLit(constVar)});
+
+    for (auto x: cone) {
+        if (x != wireID && inFanout[x]) faultyVar[x] = solver.newVar();
+    }
+    for (auto x: cone) {
+        unsigned d = c.driverOf(x);
+        if (d == NO_GATE) {
+            if (!c.isPI(x)) solver.addClause({negLit(goodVar[x])}); // Undriven wires are 0, as in the simulators.
+            continue;
+        }
+        encodeGate(d, false);
+        if (faultyVar[x] >= 0) encodeGate(d, true);
+    }
+
+    // D-chain: a differing wire that is not a primary output has a differing fanout, and the fault site differs.
+    for (auto x: cone) {
+        if (inFanout[x]) diffVar[x] = solver.newVar();
+    }
+    for (auto x: cone) {
+        if (diffVar[x] < 0) continue;
+        int d = negLit(diffVar[x]);
+        solver.addClause({d, goodLit(x), faultyLit(x)});
+        solver.addClause({d, goodLit(x) ^ 1, faultyLit(x) ^ 1});
+        if (c.isPO(x)) continue;
+        lits.assign(1, d);
+        const unsigned* fo = c.fanout(x);
+        for (unsigned i = 0; i < c.numFanout(x); i++) {
+            int v = diffVar[c.outWire[fo[i]]];
+            if (v >= 0) lits.push_back(posLit(v));
+        }
+        solver.addClause(lits);
+    }
+    solver.addClause({posLit(diffVar[wireID])});
+
+    eSatResult r = solver.solve(options.conflicts);
+    if (r == SAT_UNKNOWN) return ABORTED;
+    if (r == SAT_FALSE) return REDUNDANT;
+    for (unsigned i = 0; i < c.PIs.size(); i++) {
+        int v = goodVar[c.PIs[i]];
+        if (v >= 0) testVector.set(i, solver.modelValue(v));
+    }
+    return DETECTED;
+}
+
+unsigned satFallback (const circuit &c, const vector<pair<unsigned int, bool>> &faults, vector<podemResult> &results,
+                      unsigned numThreads, const satOptions &options, vector<bool> *decided) {
+    vector<unsigned> aborted;
+    for (unsigned f = 0; f < faults.size(); f++) {
+        if (results[f].status == ABORTED) aborted.push_back(f);
+    }
+    if (decided) decided->assign(faults.size(), false);
+    if (aborted.empty()) return 0;
+
+    threadPool pool(numThreads ? numThreads : 1);
+    vector<unique_ptr<satATPG>> engines;
+    for (unsigned i = 0; i < pool.size(); i++) engines.emplace_back(new satATPG(c));
+
+    vector<eFaultStatus> status(aborted.size());
+    pool.parallelFor(aborted.size(), [&](unsigned i, unsigned worker) {
+        satATPG &engine = *engines[worker];
+        unsigned f = aborted[i];
+        status[i] = engine.run(faults[f].first, faults[f].second, options);
+        if (status[i] == DETECTED) results[f].test = engine.test();
+    });
+
+    unsigned count = 0;
+    for (unsigned i = 0; i < aborted.size(); i++) {
+        if (status[i] == ABORTED) continue;
+        results[aborted[i]].status = status[i];
+        if (decided) (*decided)[aborted[i]] = true;
+        count++;
+    }
+    return count;
+}
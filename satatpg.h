@@ -0,0 +1,61 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ SAT based test generation for the faults that PODEM gives up on. The fault is encoded as a miter in CNF: the good
+ circuit is the fanin cone of the primary outputs that the fault can reach, the faulty circuit only duplicates the
+ fanout cone of the fault site (the rest of the faulty circuit is the good one), and the fault site is stuck at its
+ value. The test must make the site differ and carry the difference along a path of differing wires to a primary
+ output (the D-chain clauses), which is what lets the solver prune unobservable assignments quickly.
+ An unsatisfiable miter proves the fault redundant, a model gives a test (the PIs outside the cones stay X), and a
+ solve that hits its conflict limit leaves the fault aborted.
+*/
+
+#ifndef SATATPG_H
+#define SATATPG_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+#include "podem.h"
+#include "sat.h"
+
+struct satOptions {
+    uint64_t conflicts = 10000; // Per fault (0 means no limit).
+};
+
+class satATPG {
+public:
+    explicit satATPG (const circuit &cRef);
+
+    eFaultStatus run (unsigned wireID, bool sa, const satOptions &options);
+
+    // The PI values of the test (in inWires order), X for the PIs outside the fault's cone.
+    const testCube &test() const { return testVector; }
+    uint64_t conflicts() const { return solver.conflicts(); } // Conflicts of the last run.
+
+private:
+    int goodLit (unsigned wireID) const { return posLit(goodVar[wireID]); }
+    int faultyLit (unsigned wireID) const; // The good literal outside the fanout cone.
+    void encodeGate (unsigned g, bool faultyCopy);
+
+    const circuit &c;
+    satSolver solver;
+    vector<int> goodVar, faultyVar, diffVar; // Per wire, -1 if the wire is not in the miter.
+    vector<unsigned> used; // Wires with variables, to reset them for the next fault.
+    vector<bool> inFanout;
+    vector<unsigned> stack;
+    vector<int> lits;
+    unsigned faultWire = 0, constVar = 0;
+    bool faultValue = false;
+    testCube testVector;
+};
+
+// Runs the SAT engine for every fault whose result is ABORTED, on numThreads threads, and replaces the result if the
+// engine decides the fault. Returns the number of faults that it decided.
+unsigned satFallback (const circuit &c, const vector<pair<unsigned int, bool>> &faults, vector<podemResult> &results,
+                      unsigned numThreads, const satOptions &options, vector<bool> *decided = nullptr);
+
+#endif
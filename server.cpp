@@ -0,0 +1,291 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Request handling of the server mode (see server.h) and the stdin and Unix domain socket front ends.
+*/
+
+#include <cctype>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "server.h"
+#include "cktimage.h"
+#include "faultsim.h"
+#include "simd.h"
+
+static string jsonString (const string &s) {
+    string r = "\"";
+    for (char ch: s) {
+        if (ch == '"' || ch == '\\') r += '\\';
+        if (ch == '\n') r += "\\n";
+        else if ((unsigned char) ch >= 0x20) r += ch;
+    }
+    return r + "\"";
+}
+
+static string failure (const string &error) {
+    return "{\"ok\": false, \"error\": " + jsonString(error) + "}";
+}
+
+static const char* statusName[3] = {"detected", "redundant", "aborted"};
+
+bool atpgServer::load (const string &file) {
+    // The loaders report problems on cout, which is also where the stdin server answers, so they are captured.
+    ostringstream messages;
+    streambuf* coutBuf = cout.rdbuf(messages.rdbuf());
+    circuit next; // The loaded circuit stays until the new one has been read without errors.
+    bool ok = loadCircuit(file, next, options.useImage);
+    cout.rdbuf(coutBuf);
+    loadMessages = messages.str();
+    while (!loadMessages.empty() && isspace((unsigned char) loadMessages.back())) loadMessages.pop_back();
+    if (!ok) return false;
+
+    swap(c, next);
+    loaded = true;
+    learned.clear();
+    cktFile = file;
+    tape.compile(c);
+    fSet.build(c);
+    return true;
+}
+
+bool atpgServer::readVectors (istringstream &args, vector<vector<bool>> &vecs, string &error) {
+    string v;
+    while (args >> v) {
+        if (v.size() != c.PIs.size() || v.find_first_not_of("01") != string::npos) {
+            error = "Vector " + to_string(vecs.size() + 1) + " needs " + to_string(c.PIs.size()) + " bits (0 or 1).";
+            return false;
+        }
+        vecs.emplace_back(v.size());
+        for (unsigned i = 0; i < v.size(); i++) vecs.back()[i] = (v[i] == '1');
+    }
+    if (vecs.empty()) error = "No vectors were given.";
+    return !vecs.empty();
+}
+
+string atpgServer::simulate (istringstream &args) {
+    vector<vector<bool>> vecs;
+    string error;
+    if (!readVectors(args, vecs, error)) return failure(error);
+
+    vector<vector<bool>> outV = simVectorsWide(tape, vecs);
+    ostringstream r;
+    r << "{\"ok\": true, \"outputs\": [";
+    for (unsigned i = 0; i < outV.size(); i++) {
+        r << (i ? ", \"" : "\"");
+        for (auto bit: outV[i]) r << bit;
+        r << "\"";
+    }
+    r << "]}";
+    return r.str();
+}
+
+string atpgServer::atpg (istringstream &args) {
+    vector<pair<unsigned int, bool>> faults;
+    string w;
+    while (args >> w) {
+        if (w == "all") {
+            for (auto t: fSet.targets) faults.push_back(fSet.universe[t]);
+            continue;
+        }
+        int sa = -1;
+        args >> sa;
+        unsigned wireID = strtoul(w.c_str(), nullptr, 10);
+        if (!c.hasWire(wireID)) return failure("Invalid wire number " + w + " for the loaded circuit.");
+        if (sa != 0 && sa != 1) return failure("Invalid stuck at value for wire " + w + ".");
+        faults.push_back(make_pair(wireID, (bool) sa));
+    }
+    if (faults.empty()) return failure("No faults were given.");
+
+    if (options.learning && !learned.built()) learned.build(c);
+    const staticLearning *l = options.learning ? &learned : nullptr;
+    vector<podemResult> results = runPODEM(c, faults, options.threads, options.podem, l);
+    vector<bool> bySat(faults.size(), false);
+    if (options.satFlag) satFallback(c, faults, results, options.threads, options.sat, &bySat);
+    unsigned count[3] = {0, 0, 0};
+    ostringstream r;
+    r << "{\"ok\": true, \"faults\": [";
+    for (unsigned f = 0; f < faults.size(); f++) {
+        count[results[f].status]++;
+        r << (f ? ", " : "") << "{\"wire\": " << faults[f].first << ", \"sa\": " << faults[f].second;
+        r << ", \"status\": \"" << statusName[results[f].status] << "\", \"backtracks\": " << results[f].backtracks;
+        r << ", \"engine\": \"" << (bySat[f] ? "sat" : "podem") << "\"";
+        if (results[f].status == DETECTED) {
+            r << ", \"test\": \"" << results[f].test.toString() << "\"";
+        }
+        r << "}";
+    }
+    r << "], \"detected\": " << count[DETECTED] << ", \"redundant\": " << count[REDUNDANT];
+    r << ", \"aborted\": " << count[ABORTED];
+
+    if (options.compactFlag && count[DETECTED]) {
+        compactStats stats;
+        vector<vector<bool>> compacted = compactTests(c, faults, results, options.podem, options.compact, stats);
+        r << ", \"compacted\": [";
+        for (unsigned i = 0; i < compacted.size(); i++) {
+            r << (i ? ", \"" : "\"");
+            for (auto bit: compacted[i]) r << bit;
+            r << "\"";
+        }
+        r << "], \"patternsBeforeCompaction\": " << stats.initial;
+    }
+    r << "}";
+    return r.str();
+}
+
+// Parallel PPSFP with fault dropping on the collapsed targets, expanded to the whole universe.
+string atpgServer::faultSim (istringstream &args) {
+    vector<vector<bool>> vecs;
+    string error;
+    if (!readVectors(args, vecs, error)) return failure(error);
+
+    vector<pair<unsigned int, bool>> targets;
+    for (auto t: fSet.targets) targets.push_back(fSet.universe[t]);
+    parallelFaultSim fSim(c, tape, options.threads);
+    vector<int> targetFirst = fSim.firstDetection(targets, vecs);
+
+    vector<int> first = fSet.expand(targetFirst);
+    unsigned detected = 0, missed = 0;
+    ostringstream undetected;
+    for (unsigned f = 0; f < first.size(); f++) {
+        if (first[f] >= 0) detected++;
+        else undetected << (missed++ ? ", [" : "[") << fSet.universe[f].first << ", " << fSet.universe[f].second << "]";
+    }
+    ostringstream r;
+    r << "{\"ok\": true, \"vectors\": " << vecs.size() << ", \"faults\": " << first.size() << ", \"detected\": " << detected;
+    r << ", \"coverage\": " << (first.empty() ? 0.0 : (double) detected / first.size());
+    r << ", \"undetected\": [" << undetected.str() << "]}";
+    return r.str();
+}
+
+string atpgServer::setOption (istringstream &args) {
+    string name, value;
+    if (!(args >> name >> value)) return failure("set needs an option name and a value.");
+    try {
+        if (name == "backtracks") options.podem.backtracks = stoul(value);
+        else if (name == "time-limit") options.podem.seconds = stod(value);
+        else if (name == "threads") options.threads = max(1ul, stoul(value));
+        else if (name == "compact") options.compactFlag = (value != "0");
+        else if (name == "learning") options.learning = (value != "0");
+        else if (name == "sat") options.satFlag = (value != "0");
+        else if (name == "sat-conflicts") options.sat.conflicts = stoull(value);
+        else return failure("Unknown option " + name + ".");
+    }
+    catch (const exception &) {
+        return failure("Invalid value " + value + " for " + name + ".");
+    }
+    return "{\"ok\": true}";
+}
+
+string atpgServer::info() {
+    ostringstream r;
+    r << "{\"ok\": true, \"circuit\": " << jsonString(cktFile) << ", \"inputs\": " << c.PIs.size();
+    r << ", \"outputs\": " << c.POs.size() << ", \"gates\": " << c.numGates() << ", \"levels\": " << c.maxLevel;
+    r << ", \"faults\": " << fSet.universe.size() << ", \"collapsedFaults\": " << fSet.targets.size();
+    r << ", \"backtracks\": " << options.podem.backtracks << ", \"time-limit\": " << options.podem.seconds;
+    r << ", \"threads\": " << options.threads << ", \"compact\": " << (options.compactFlag ? "true" : "false");
+    r << ", \"learning\": " << (options.learning ? "true" : "false");
+    if (learned.built()) {
+        r << ", \"implications\": " << learned.implications() << ", \"learningSeconds\": " << learned.seconds();
+    }
+    r << ", \"sat\": " << (options.satFlag ? "true" : "false") << ", \"sat-conflicts\": " << options.sat.conflicts << "}";
+    return r.str();
+}
+
+string atpgServer::handle (const string &request) {
+    istringstream args(request);
+    string command;
+    if (!(args >> command) || command[0] == '#') return "";
+
+    if (command == "quit" || command == "shutdown") {
+        quit = true;
+        shutdown = (command == "shutdown");
+        return "{\"ok\": true}";
+    }
+    if (command == "load") {
+        string file;
+        if (!(args >> file)) return failure("load needs a circuit file.");
+        if (!load(file)) return failure("The circuit " + file + " could not be loaded. " + loadMessages);
+        return info();
+    }
+    if (command == "set") return setOption(args);
+    if (!loaded) return failure("No circuit is loaded.");
+    if (command == "simulate") return simulate(args);
+    if (command == "atpg") return atpg(args);
+    if (command == "faultsim") return faultSim(args);
+    if (command == "info") return info();
+    return failure("Unknown request " + command + ".");
+}
+
+void atpgServer::serve (istream &in, ostream &out) {
+    string line;
+    quit = false;
+    while (!quit && getline(in, line)) {
+        string response = handle(line);
+        if (!response.empty()) out << response << endl;
+    }
+}
+
+// Returns false if the client went away. MSG_NOSIGNAL turns a closed connection into EPIPE instead of a SIGPIPE that
+// would stop the whole server.
+static bool writeAll (int fd, const string &s) {
+    size_t done = 0;
+    while (done < s.size()) {
+        ssize_t n = send(fd, s.data() + done, s.size() - done, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+bool atpgServer::serveSocket (const string &path) {
+    sockaddr_un addr = {};
+    if (path.size() >= sizeof(addr.sun_path)) return false;
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, path.size());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) return false;
+    unlink(path.c_str()); // A socket file left by an earlier server.
+    if (bind(listenFd, (sockaddr*) &addr, sizeof(addr)) < 0 || listen(listenFd, 8) < 0) {
+        close(listenFd);
+        return false;
+    }
+
+    // Clients are served one at a time, each until it sends quit or closes the connection.
+    shutdown = false;
+    while (!shutdown) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        string buffer;
+        char chunk[4096];
+        quit = false;
+        while (!quit) {
+            ssize_t n = read(fd, chunk, sizeof(chunk));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            buffer.append(chunk, n);
+
+            size_t end;
+            while (!quit && (end = buffer.find('\n')) != string::npos) {
+                string response = handle(buffer.substr(0, end));
+                buffer.erase(0, end + 1);
+                if (!response.empty() && !writeAll(fd, response + "\n")) quit = true; // Only ends this client.
+            }
+        }
+        close(fd);
+    }
+
+    close(listenFd);
+    unlink(path.c_str());
+    return true;
+}
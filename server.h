@@ -0,0 +1,79 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Server mode. The circuit is parsed once and stays loaded while requests are read one per line (from stdin or from the
+ clients of a Unix domain socket, one client at a time), and every request is answered with one line of JSON, so a
+ script can run many jobs on the same circuit without paying for a process start and a netlist load each time.
+ Requests (vectors are strings of 0s and 1s, one character per primary input in inWires order):
+   load FILE                  loads a circuit (through its binary image unless --no-image was given)
+   simulate V1 V2 ..          primary output values of every vector
+   atpg all | W1 S1 W2 S2 ..  PODEM (and SAT for what it aborts) on the collapsed or listed faults, and the compacted
+                              test set
+   faultsim V1 V2 ..          coverage of the fault universe by the vectors (on all threads) and the undetected faults
+   set backtracks|time-limit|threads|compact|learning|sat|sat-conflicts VALUE
+   info                       the loaded circuit and the current settings
+   quit                       ends the session (stdin: stops the server), shutdown also stops the socket server
+ Every response has "ok": true, or "ok": false and an "error" message. Empty lines and lines starting with # are
+ ignored, so a file of requests can be piped through --serve as a batch job.
+*/
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "circuit.h"
+#include "compact.h"
+#include "faults.h"
+#include "podem.h"
+#include "learn.h"
+#include "satatpg.h"
+#include "tape.h"
+
+struct serverOptions {
+    podemOptions podem;
+    compactOptions compact;
+    bool compactFlag = true;
+    bool learning = true; // Static learning for PODEM (built at the first atpg request after a load).
+    bool satFlag = true; // SAT engine for the faults that PODEM aborts.
+    satOptions sat;
+    unsigned threads = 1;
+    bool useImage = true;
+};
+
+class atpgServer {
+public:
+    explicit atpgServer (const serverOptions &o) : options(o) {}
+
+    bool load (const string &file);
+
+    // Answers one request. Returns an empty string for blank and comment lines.
+    string handle (const string &request);
+
+    void serve (istream &in, ostream &out); // Until quit or the end of the input.
+    bool serveSocket (const string &path); // Until shutdown. Returns false if the socket could not be opened.
+
+private:
+    string simulate (istringstream &args);
+    string atpg (istringstream &args);
+    string faultSim (istringstream &args);
+    string setOption (istringstream &args);
+    string info();
+    bool readVectors (istringstream &args, vector<vector<bool>> &vecs, string &error);
+
+    serverOptions options;
+    circuit c;
+    compiledCircuit tape;
+    faultSet fSet;
+    staticLearning learned; // Of the loaded circuit, built when an atpg request first needs it.
+    string cktFile;
+    string loadMessages; // What the loader printed for the last load.
+    bool loaded = false;
+    bool quit = false, shutdown = false;
+};
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ SIMD simulation kernels and their run time dispatch (see simd.h).
+ The kernels are written once, as always inline templates over a wide word type (GCC vector types of 256 or 512 bits,
+ or a plain uint64_t), and are inlined into entry points that carry the AVX2 or AVX-512 target attribute, so the
+ compiler emits the ymm/zmm instructions there while the rest of the program stays built for the baseline processor.
+*/
+
+#include "simd.h"
+
+// Slot values are kept in 64 byte aligned storage (simdBlock), so the words of a slot can be loaded as one vector.
+typedef uint64_t word256 __attribute__((vector_size(32)));
+typedef uint64_t word512 __attribute__((vector_size(64)));
+
+template <unsigned W> struct wideWord;
+template <> struct wideWord<64> { typedef uint64_t type; };
+template <> struct wideWord<256> { typedef word256 type; };
+template <> struct wideWord<512> { typedef word512 type; };
+
+#define KERNEL static inline __attribute__((always_inline))
+
+// The kernels pass wide words by value, which would change the calling convention if they were not always inlined.
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+template <typename V>
+KERNEL bool anyBit (const V &v) {
+    uint64_t r = 0;
+    for (unsigned l = 0; l < sizeof(V) / 8; l++) r |= v[l];
+    return r != 0;
+}
+KERNEL bool anyBit (const uint64_t &v) { return v != 0; }
+
+// Value of instruction I over the words of val.
+template <typename V>
+KERNEL V evalInstr (const V* val, const tapeInstr &I, const uint32_t* wide) {
+    switch (I.op) {
+        case OP_AND2: return val[I.a] & val[I.b];
+        case OP_NAND2: return ~(val[I.a] & val[I.b]);
+        case OP_OR2: return val[I.a] | val[I.b];
+        case OP_NOR2: return ~(val[I.a] | val[I.b]);
+        case OP_INV: return ~val[I.a];
+        case OP_BUF: return val[I.a];
+        default: break;
+    }
+    const uint32_t* in = wide + I.a;
+    V r = val[in[0]];
+    bool isAnd = (I.op == OP_AND) || (I.op == OP_NAND);
+    for (uint32_t i = 1; i < I.b; i++) r = isAnd ? (r & val[in[i]]) : (r | val[in[i]]);
+    return ((I.op == OP_NAND) || (I.op == OP_NOR)) ? ~r : r;
+}
+
+template <unsigned W>
+KERNEL void runTapeK (const compiledCircuit &t, uint64_t* words) {
+    typedef typename wideWord<W>::type V;
+    V* val = reinterpret_cast<V*>(words);
+    const uint32_t* wide = t.wideOperands().data();
+    for (const tapeInstr &I: t.instructions()) val[I.out] = evalInstr(val, I, wide);
+}
+
+// Event driven propagation of a fault through the fanout cone of its slot (see wideFaultSim::detect).
+struct faultCone {
+    const vector<uint32_t> &fanoutStart, &fanoutInstr, &instrLevel;
+    const vector<bool> &poSlot;
+    vector<vector<uint32_t>> &levelQueue;
+    vector<bool> &queued;
+    vector<uint32_t> &touched;
+};
+
+template <unsigned W>
+KERNEL void detectK (const compiledCircuit &t, faultCone &fc, const uint64_t* goodWords, uint64_t* faultyWords,
+                     uint32_t slot, bool sa, const uint64_t* maskWords, uint64_t* detWords) {
+    typedef typename wideWord<W>::type V;
+    const V* good = reinterpret_cast<const V*>(goodWords);
+    V* faulty = reinterpret_cast<V*>(faultyWords);
+    const vector<tapeInstr> &tape = t.instructions();
+    const uint32_t* wide = t.wideOperands().data();
+    V det = good[slot] ^ good[slot]; // All zero.
+    V mask;
+    __builtin_memcpy(&mask, maskWords, sizeof(V)); // The caller's words need not be aligned.
+
+    V stuck = sa ? ~det : det;
+    if (!anyBit(stuck ^ good[slot])) { // No vector of the block excites the fault.
+        __builtin_memcpy(detWords, &det, sizeof(V));
+        return;
+    }
+
+    unsigned low = UINT32_MAX, high = 0;
+    auto schedule = [&](uint32_t s) {
+        for (uint32_t k = fc.fanoutStart[s]; k < fc.fanoutStart[s+1]; k++) {
+            uint32_t i = fc.fanoutInstr[k];
+            if (fc.queued[i]) continue;
+            fc.queued[i] = true;
+            uint32_t l = fc.instrLevel[i];
+            fc.levelQueue[l].push_back(i);
+            if (l < low) low = l;
+            if (l > high) high = l;
+        }
+    };
+
+    faulty[slot] = stuck;
+    fc.touched.push_back(slot);
+    if (fc.poSlot[slot]) det = det | (stuck ^ good[slot]);
+    schedule(slot);
+
+    for (unsigned l = low; l <= high && low <= high; l++) {
+        for (unsigned q = 0; q < fc.levelQueue[l].size(); q++) {
+            uint32_t i = fc.levelQueue[l][q];
+            fc.queued[i] = false;
+            const tapeInstr &I = tape[i];
+            V v = evalInstr(faulty, I, wide);
+            V diff = v ^ good[I.out];
+            if (!anyBit(diff ^ (faulty[I.out] ^ good[I.out]))) continue; // The faulty value did not change.
+            faulty[I.out] = v;
+            fc.touched.push_back(I.out);
+            if (fc.poSlot[I.out]) det = det | diff;
+            schedule(I.out);
+        }
+        fc.levelQueue[l].clear();
+    }
+
+    for (auto s: fc.touched) faulty[s] = good[s];
+    fc.touched.clear();
+    det = det & mask;
+    __builtin_memcpy(detWords, &det, sizeof(V));
+}
+
+// Entry points: one per width, the wide ones compiled for the instruction set they need.
+
+static void runTape64 (const compiledCircuit &t, uint64_t* w) { runTapeK<64>(t, w); }
+__attribute__((target("avx2"))) static void runTape256 (const compiledCircuit &t, uint64_t* w) { runTapeK<256>(t, w); }
+__attribute__((target("avx512f"))) static void runTape512 (const compiledCircuit &t, uint64_t* w) { runTapeK<512>(t, w); }
+
+static void detect64 (const compiledCircuit &t, faultCone &fc, const uint64_t* g, uint64_t* f, uint32_t s, bool sa,
+                      const uint64_t* m, uint64_t* d) { detectK<64>(t, fc, g, f, s, sa, m, d); }
+__attribute__((target("avx2")))
+static void detect256 (const compiledCircuit &t, faultCone &fc, const uint64_t* g, uint64_t* f, uint32_t s, bool sa,
+                       const uint64_t* m, uint64_t* d) { detectK<256>(t, fc, g, f, s, sa, m, d); }
+__attribute__((target("avx512f")))
+static void detect512 (const compiledCircuit &t, faultCone &fc, const uint64_t* g, uint64_t* f, uint32_t s, bool sa,
+                       const uint64_t* m, uint64_t* d) { detectK<512>(t, fc, g, f, s, sa, m, d); }
+
+static size_t blocksFor (size_t words) { return (words + 7) / 8 + 1; } // Never empty.
+static uint64_t* wordsOf (vector<simdBlock> &b) { return reinterpret_cast<uint64_t*>(b.data()); }
+
+static unsigned cpuWidth() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return 512;
+    if (__builtin_cpu_supports("avx2")) return 256;
+    return 64;
+}
+
+static unsigned maxWidth = 512; // Set by setSimdWidth.
+
+unsigned simdWidth() {
+    static const unsigned supported = cpuWidth();
+    return (supported < maxWidth) ? supported : maxWidth;
+}
+
+void setSimdWidth (unsigned bits) {
+    maxWidth = (bits >= 512) ? 512 : (bits >= 256) ? 256 : 64;
+}
+
+static void runTapeWide (const compiledCircuit &t, uint64_t* words, unsigned width) {
+    if (width == 512) runTape512(t, words);
+    else if (width == 256) runTape256(t, words);
+    else runTape64(t, words);
+}
+
+void packWide (const vector<vector<bool>> &vecs, unsigned first, unsigned count, unsigned words, vector<uint64_t> &piWords) {
+    unsigned numIn = vecs.empty() ? 0 : vecs[first].size();
+    piWords.assign(numIn * words, 0);
+    for (unsigned k = 0; k < count; k++) {
+        const vector<bool> &v = vecs[first + k];
+        for (unsigned i = 0; i < numIn; i++) {
+            if (v[i]) piWords[i * words + k / 64] |= 1ULL << (k % 64);
+        }
+    }
+}
+
+vector<vector<bool>> simVectorsWide (const compiledCircuit &t, const vector<vector<bool>> &vecs) {
+    unsigned width = simdWidth(), words = width / 64;
+    vector<vector<bool>> outVals(vecs.size(), vector<bool>(t.poSlot.size()));
+    vector<uint64_t> piWords;
+    vector<simdBlock> block(blocksFor(t.numSlots() * words));
+    uint64_t* val = wordsOf(block);
+
+    for (unsigned first = 0; first < vecs.size(); first += width) {
+        unsigned count = (vecs.size() - first < width) ? vecs.size() - first : width;
+        packWide(vecs, first, count, words, piWords);
+        for (unsigned i = 0; i < t.piSlot.size(); i++) {
+            for (unsigned l = 0; l < words; l++) val[t.piSlot[i] * words + l] = piWords[i * words + l];
+        }
+        runTapeWide(t, val, width);
+
+        for (unsigned o = 0; o < t.poSlot.size(); o++) {
+            const uint64_t* w = &val[t.poSlot[o] * words];
+            for (unsigned k = 0; k < count; k++) outVals[first + k][o] = (w[k / 64] >> (k % 64)) & 1;
+        }
+    }
+    return outVals;
+}
+
+wideFaultSim::wideFaultSim (const circuit &cRef, const compiledCircuit &tRef) : c(cRef), t(tRef), width(simdWidth()) {
+    const vector<tapeInstr> &tape = t.instructions();
+    unsigned nS = t.numSlots();
+
+    // Fanout of every slot in tape instructions, and the level of every instruction (the tape is in c.order).
+    fanoutStart.assign(nS + 1, 0);
+    auto forInputs = [&](const tapeInstr &I, auto f) {
+        if (I.op < OP_AND) {
+            f(I.a);
+            if (I.op < OP_INV) f(I.b);
+        }
+        else for (uint32_t k = 0; k < I.b; k++) f(t.wideOperands()[I.a + k]);
+    };
+    for (auto &I: tape) forInputs(I, [&](uint32_t s) { fanoutStart[s + 1]++; });
+    for (unsigned s = 0; s < nS; s++) fanoutStart[s + 1] += fanoutStart[s];
+    fanoutInstr.resize(fanoutStart[nS]);
+    vector<uint32_t> fill(fanoutStart.begin(), fanoutStart.end() - 1);
+    for (uint32_t i = 0; i < tape.size(); i++) forInputs(tape[i], [&](uint32_t s) { fanoutInstr[fill[s]++] = i; });
+
+    instrLevel.resize(tape.size());
+    for (uint32_t i = 0; i < tape.size(); i++) instrLevel[i] = c.level[c.order[i]];
+    levelQueue.resize(c.maxLevel + 1);
+    queued.assign(tape.size(), false);
+    poSlot.assign(nS, false);
+    for (auto s: t.poSlot) poSlot[s] = true;
+
+    good.assign(blocksFor(nS * words()), simdBlock());
+    faulty = good;
+}
+
+void wideFaultSim::goodSim (const vector<uint64_t> &piWords) {
+    unsigned words = this->words();
+    for (unsigned i = 0; i < t.piSlot.size(); i++) {
+        for (unsigned l = 0; l < words; l++) wordsOf(good)[t.piSlot[i] * words + l] = piWords[i * words + l];
+    }
+    runTapeWide(t, wordsOf(good), width);
+    faulty = good;
+}
+
+void wideFaultSim::detect (unsigned wireID, bool sa, const uint64_t* mask, uint64_t* det) {
+    uint32_t slot = (wireID < t.slotOf.size()) ? t.slotOf[wireID] : UINT32_MAX;
+    if (slot == UINT32_MAX) { // Not a wire of the circuit.
+        for (unsigned l = 0; l < words(); l++) det[l] = 0;
+        return;
+    }
+
+    faultCone fc = {fanoutStart, fanoutInstr, instrLevel, poSlot, levelQueue, queued, touched};
+    if (width == 512) detect512(t, fc, wordsOf(good), wordsOf(faulty), slot, sa, mask, det);
+    else if (width == 256) detect256(t, fc, wordsOf(good), wordsOf(faulty), slot, sa, mask, det);
+    else detect64(t, fc, wordsOf(good), wordsOf(faulty), slot, sa, mask, det);
+}
@@ -0,0 +1,66 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ SIMD-wide pattern words. The simulation kernels are templates on the pattern word width (64, 256 or 512 bits, i.e.
+ 64, 256 or 512 test vectors per pass) and run the instruction tape of the circuit (see tape.h). The 256 and 512 bit
+ kernels are compiled for AVX2 and AVX-512 and the widest one the processor supports is picked at run time; the 64 bit
+ kernel is the scalar fallback for every other machine. A block of vectors gives the same results whatever kernel
+ simulates it, only the number of vectors per pass changes.
+ Pattern words of a block are stored slot major: words() consecutive uint64_t per slot (or per PI), where word l holds
+ vectors 64*l .. 64*l+63 of the block.
+*/
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+#include "tape.h"
+
+// 64 byte aligned storage for pattern words.
+struct alignas(64) simdBlock {
+    uint64_t w[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+};
+
+// Widest kernel (in bits) that this processor supports, capped by setSimdWidth.
+unsigned simdWidth();
+void setSimdWidth (unsigned bits); // 64, 256 or 512, e.g. to compare the kernels.
+
+// Packs vectors first .. first+count-1 (count <= bits) into words = bits/64 words per primary input.
+void packWide (const vector<vector<bool>> &vecs, unsigned first, unsigned count, unsigned words, vector<uint64_t> &piWords);
+
+// Good machine outputs of every vector (like compiledCircuit::simVectors), simdWidth() vectors per pass of the tape.
+vector<vector<bool>> simVectorsWide (const compiledCircuit &t, const vector<vector<bool>> &vecs);
+
+// Pattern-parallel single fault propagation with SIMD-wide words: the PPSFP simulator of ppsfp.h over blocks of
+// simdWidth() vectors, event driven through the tape.
+class wideFaultSim {
+public:
+    wideFaultSim (const circuit &cRef, const compiledCircuit &tRef);
+
+    unsigned bits() const { return width; } // Vectors per block.
+    unsigned words() const { return width / 64; }
+
+    void goodSim (const vector<uint64_t> &piWords); // piWords from packWide with words().
+
+    // Sets det (words() words) to the vectors of the block that detect wireID s-a-sa, limited to mask (words() words).
+    void detect (unsigned wireID, bool sa, const uint64_t* mask, uint64_t* det);
+
+private:
+    const circuit &c;
+    const compiledCircuit &t;
+    unsigned width;
+    vector<simdBlock> good, faulty; // words() words per slot.
+    vector<uint32_t> fanoutStart, fanoutInstr; // Tape instructions that read each slot.
+    vector<uint32_t> instrLevel;
+    vector<bool> poSlot;
+    vector<vector<uint32_t>> levelQueue;
+    vector<bool> queued;
+    vector<uint32_t> touched;
+};
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Synthetic benchmark circuit generator (see synth.h).
+*/
+
+#include <algorithm>
+#include <fstream>
+#include "synth.h"
+#include "randpat.h"
+
+static const char* gateName (eGate t) {
+    switch (t) {
+        case INV: return "INV";
+        case BUF: return "BUF";
+        case AND: return "AND";
+        case NAND: return "NAND";
+        case OR: return "OR";
+        default: return "NOR";
+    }
+}
+
+bool writeSynthetic (const string &path, const synthParams &p, vector<pair<unsigned int, bool>> &redundantFaults) {
+    ofstream out(path);
+    if (!out.is_open() || !p.inputs || !p.depth || (p.gates < 2 * p.redundant + p.depth)) return false;
+
+    patternRng rng(p.seed);
+    auto below = [&](unsigned n) { return (unsigned) (rng.next() % n); };
+    auto chance = [&](double prob) { return (rng.next() >> 11) * (1.0 / 9007199254740992.0) < prob; };
+
+    vector<vector<unsigned>> levels(p.depth + 1); // Wires that gates of the next levels can use as inputs.
+    vector<unsigned> fanouts(p.inputs + p.gates + 1, 0);
+    unsigned next = 1;
+    for (unsigned i = 0; i < p.inputs; i++) levels[0].push_back(next++);
+    redundantFaults.clear();
+
+    // Picks an input wire for a gate of level l.
+    auto pickInput = [&](unsigned l, bool first) {
+        unsigned from = (!first && chance(p.reconvergence)) ? below(l) : l - 1;
+        const vector<unsigned> &pool = levels[from];
+        return pool[below(pool.size())];
+    };
+
+    unsigned plain = p.gates - 2 * p.redundant;
+    vector<unsigned> redundantAt(p.redundant); // Level of every redundant structure.
+    for (auto &l: redundantAt) l = 1 + below(p.depth);
+    sort(redundantAt.begin(), redundantAt.end());
+
+    unsigned r = 0;
+    vector<unsigned> in;
+    for (unsigned l = 1; l <= p.depth; l++) {
+        unsigned count = plain / p.depth + (l <= plain % p.depth);
+        for (unsigned k = 0; k < count; k++) {
+            eGate t;
+            unsigned pick = below(16);
+            if (pick == 0) t = INV;
+            else if (pick == 1) t = BUF;
+            else {
+                static const eGate multi[4] = {AND, NAND, OR, NOR};
+                t = multi[pick % 4];
+            }
+
+            unsigned n = (t == INV || t == BUF) ? 1 : 2 + ((p.fanin > 2) ? below(p.fanin - 1) : 0);
+            in.clear();
+            for (unsigned i = 0; i < n; i++) {
+                unsigned w = pickInput(l, i == 0);
+                for (int retry = 0; retry < 4 && find(in.begin(), in.end(), w) != in.end(); retry++) w = pickInput(l, false);
+                if (find(in.begin(), in.end(), w) == in.end()) in.push_back(w);
+            }
+            if (in.size() < 2 && t != INV && t != BUF) t = (t == NAND || t == NOR) ? INV : BUF;
+
+            out << gateName(t);
+            for (auto w: in) {
+                out << " " << w;
+                fanouts[w]++;
+            }
+            out << " " << next << "\n";
+            levels[l].push_back(next++);
+        }
+
+        // w2 = OR(a, AND(a, b)) is just a, so the AND output w1 stuck-at-0 is redundant.
+        for (; r < redundantAt.size() && redundantAt[r] == l; r++) {
+            unsigned a = pickInput(l, true), b = pickInput(l, false);
+            if (b == a) b = (a == levels[0][0]) ? levels[0].back() : levels[0][0];
+            unsigned w1 = next++, w2 = next++;
+            out << "AND " << a << " " << b << " " << w1 << "\n";
+            out << "OR " << a << " " << w1 << " " << w2 << "\n";
+            fanouts[a] += 2;
+            fanouts[b]++;
+            fanouts[w1]++;
+            levels[l].push_back(w2);
+            redundantFaults.push_back(make_pair(w1, false));
+        }
+    }
+
+    // Every gate output that drives nothing is a primary output, as well as the whole last level.
+    out << "INPUT";
+    for (auto w: levels[0]) out << " " << w;
+    out << " -1\nOUTPUT";
+    for (auto w: levels[p.depth]) fanouts[w] = 0;
+    for (unsigned w = p.inputs + 1; w < next; w++) {
+        if (!fanouts[w]) out << " " << w;
+    }
+    out << " -1\n";
+    return out.good();
+}
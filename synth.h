@@ -0,0 +1,36 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Generator of synthetic combinational circuits for benchmarking. The circuit is built level by level: every gate takes
+ its first input from the previous level (so the circuit has the requested depth) and each other input either from
+ the previous level or, with the reconvergence probability, from any earlier level, which creates reconvergent fanout.
+ A number of redundant structures OR(a, AND(a, b)) are mixed in; the AND output stuck-at-0 of each of them cannot be
+ detected, so PODEM has to prove it redundant. The circuit is written in the original circuit file format, and the
+ same parameters (including the seed) always give the same file.
+*/
+
+#ifndef SYNTH_H
+#define SYNTH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Classes.h"
+
+struct synthParams {
+    unsigned inputs = 32;
+    unsigned gates = 2000;
+    unsigned depth = 24;
+    unsigned fanin = 2; // Maximum gate fan-in (2 keeps the circuit usable by the deductive simulator).
+    double reconvergence = 0.25; // Probability that an input comes from any earlier level instead of the previous one.
+    unsigned redundant = 8; // Redundant structures (two gates each, counted in gates).
+    uint64_t seed = 1;
+};
+
+// Writes the circuit to path. redundantFaults receives the faults that are redundant by construction.
+bool writeSynthetic (const string &path, const synthParams &p, vector<pair<unsigned int, bool>> &redundantFaults);
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Lowering of the levelized circuit to an instruction tape (see tape.h).
+*/
+
+#include "tape.h"
+#include "psim.h"
+
+void compiledCircuit::compile (const circuit &c) {
+    tape.clear();
+    wideIn.clear();
+    slotOf.assign(c.numWires(), UINT32_MAX);
+    slots = 0;
+
+    for (auto w: c.PIs) slotOf[w] = slots++;
+    for (unsigned g: c.order) slotOf[c.outWire[g]] = slots++;
+    auto slot = [&](unsigned w) { // Undriven inputs get a slot of their own that stays 0.
+        if (slotOf[w] == UINT32_MAX) slotOf[w] = slots++;
+        return slotOf[w];
+    };
+
+    tape.reserve(c.numGates());
+    for (unsigned g: c.order) {
+        const unsigned* in = c.fanin(g);
+        unsigned n = c.numFanin(g);
+        tapeInstr I;
+        I.out = slotOf[c.outWire[g]];
+        I.a = slot(in[0]);
+        I.b = (n > 1) ? slot(in[1]) : 0;
+
+        switch (c.type[g]) {
+            case INV: I.op = OP_INV; break;
+            case BUF: I.op = OP_BUF; break;
+            case AND: I.op = (n == 2) ? OP_AND2 : OP_AND; break;
+            case NAND: I.op = (n == 2) ? OP_NAND2 : OP_NAND; break;
+            case OR: I.op = (n == 2) ? OP_OR2 : OP_OR; break;
+            default: I.op = (n == 2) ? OP_NOR2 : OP_NOR; break;
+        }
+        if (I.op >= OP_AND) { // One input or more than two: the operands go to wideIn.
+            I.a = wideIn.size();
+            I.b = n;
+            for (unsigned i = 0; i < n; i++) wideIn.push_back(slot(in[i]));
+        }
+        tape.push_back(I);
+    }
+
+    piSlot.clear();
+    poSlot.clear();
+    for (auto w: c.PIs) piSlot.push_back(slotOf[w]);
+    for (auto w: c.POs) poSlot.push_back(slot(w));
+}
+
+vector<vector<bool>> compiledCircuit::simVectors (const vector<vector<bool>> &vecs) const {
+    vector<vector<bool>> outVals(vecs.size(), vector<bool>(poSlot.size()));
+    vector<uint64_t> piWords;
+    vector<uint64_t> val(slots, 0);
+
+    for (unsigned first = 0; first < vecs.size(); first += BLOCK_SIZE) {
+        unsigned count = (vecs.size() - first < BLOCK_SIZE) ? vecs.size() - first : BLOCK_SIZE;
+        packVectors(vecs, first, count, piWords);
+        for (unsigned i = 0; i < piSlot.size() && i < piWords.size(); i++) val[piSlot[i]] = piWords[i];
+        run(val.data());
+
+        for (unsigned o = 0; o < poSlot.size(); o++) {
+            uint64_t w = val[poSlot[o]];
+            for (unsigned k = 0; k < count; k++) outVals[first + k][o] = (w >> k) & 1;
+        }
+    }
+    return outVals;
+}
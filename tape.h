@@ -0,0 +1,94 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Compiled simulation of the levelized circuit. The circuit is lowered once to a flat instruction tape: every gate
+ becomes one instruction (an opcode and the indices of its operand slots), in topological order, and every wire gets
+ a slot in one dense value array (the primary inputs first, then the gate outputs in the order they are computed), so
+ running the tape is a single pass over two arrays without pointers, fanout lists or readiness checks.
+ Two-input gates and inverters/buffers have their own opcodes that read their operands straight from the instruction;
+ wider gates read their operand slots from a separate list. The interpreter is a template over the value type, so the
+ same tape simulates one 64-bit pattern word per slot or wider (SIMD) words, and every opcode is a specialization of
+ evalOp that the compiler inlines into the dispatch loop.
+*/
+
+#ifndef TAPE_H
+#define TAPE_H
+
+#include <cstdint>
+#include <vector>
+#include "circuit.h"
+
+enum eOp : uint8_t {OP_AND2, OP_NAND2, OP_OR2, OP_NOR2, OP_INV, OP_BUF, OP_AND, OP_NAND, OP_OR, OP_NOR};
+
+struct tapeInstr {
+    eOp op;
+    uint32_t out; // Output slot.
+    uint32_t a, b; // Input slots, or for the wide opcodes the first entry in wideIn and the number of inputs.
+};
+
+class compiledCircuit {
+public:
+    compiledCircuit() = default;
+    explicit compiledCircuit (const circuit &c) { compile(c); }
+    void compile (const circuit &c);
+
+    unsigned numSlots() const { return slots; }
+    const vector<tapeInstr> &instructions() const { return tape; }
+    const vector<uint32_t> &wideOperands() const { return wideIn; }
+
+    // Evaluates the tape over val (numSlots() words, with the PI slots set). Slots that no gate drives (wires without
+    // a driver that are not primary inputs) are never written and keep the value they were given.
+    template <typename W>
+    void run (W* val) const {
+        const uint32_t* w = wideIn.data();
+        for (const tapeInstr &I: tape) {
+            switch (I.op) {
+                case OP_AND2: val[I.out] = evalOp<OP_AND2>(val, I, w); break;
+                case OP_NAND2: val[I.out] = evalOp<OP_NAND2>(val, I, w); break;
+                case OP_OR2: val[I.out] = evalOp<OP_OR2>(val, I, w); break;
+                case OP_NOR2: val[I.out] = evalOp<OP_NOR2>(val, I, w); break;
+                case OP_INV: val[I.out] = evalOp<OP_INV>(val, I, w); break;
+                case OP_BUF: val[I.out] = evalOp<OP_BUF>(val, I, w); break;
+                case OP_AND: val[I.out] = evalOp<OP_AND>(val, I, w); break;
+                case OP_NAND: val[I.out] = evalOp<OP_NAND>(val, I, w); break;
+                case OP_OR: val[I.out] = evalOp<OP_OR>(val, I, w); break;
+                default: val[I.out] = evalOp<OP_NOR>(val, I, w); break;
+            }
+        }
+    }
+
+    // Good machine outputs of every vector (one value per PO, in POs order), 64 vectors per pass of the tape.
+    vector<vector<bool>> simVectors (const vector<vector<bool>> &vecs) const;
+
+    vector<uint32_t> piSlot; // Slot of PIs[i].
+    vector<uint32_t> poSlot; // Slot of POs[o].
+    vector<uint32_t> slotOf; // Slot of every wire ID (UINT32_MAX if the wire is not used).
+
+private:
+    template <eOp op, typename W>
+    static W evalOp (const W* val, const tapeInstr &I, const uint32_t* wide) {
+        if (op == OP_AND2) return val[I.a] & val[I.b];
+        if (op == OP_NAND2) return ~(val[I.a] & val[I.b]);
+        if (op == OP_OR2) return val[I.a] | val[I.b];
+        if (op == OP_NOR2) return ~(val[I.a] | val[I.b]);
+        if (op == OP_INV) return ~val[I.a];
+        if (op == OP_BUF) return val[I.a];
+
+        const uint32_t* in = wide + I.a;
+        W r = val[in[0]];
+        for (uint32_t i = 1; i < I.b; i++) {
+            if (op == OP_AND || op == OP_NAND) r = r & val[in[i]];
+            else r = r | val[in[i]];
+        }
+        return (op == OP_NAND || op == OP_NOR) ? ~r : r;
+    }
+
+    vector<tapeInstr> tape;
+    vector<uint32_t> wideIn; // Operand slots of the gates with more than two inputs.
+    unsigned slots = 0;
+};
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Work-stealing thread pool (see threadpool.h).
+*/
+
+#include "threadpool.h"
+
+threadPool::threadPool (unsigned numThreads) {
+    if (numThreads == 0) numThreads = 1;
+    for (unsigned i = 0; i < numThreads; i++) ranges.emplace_back(new workRange);
+    for (unsigned i = 1; i < numThreads; i++) workers.emplace_back(&threadPool::workerLoop, this, i);
+}
+
+threadPool::~threadPool() {
+    {
+        lock_guard<mutex> lock(m);
+        stop = true;
+    }
+    startCv.notify_all();
+    for (auto &w: workers) w.join();
+}
+
+void threadPool::parallelFor (unsigned n, const function<void(unsigned, unsigned)> &task) {
+    if (n == 0) return;
+
+    // Deal the indices out in equal contiguous ranges before waking the helpers up.
+    unsigned numThreads = size();
+    for (unsigned i = 0; i < numThreads; i++) {
+        ranges[i]->begin = (unsigned long long) n * i / numThreads;
+        ranges[i]->end = (unsigned long long) n * (i + 1) / numThreads;
+    }
+
+    {
+        lock_guard<mutex> lock(m);
+        job = &task;
+        busy = workers.size();
+        generation++;
+    }
+    startCv.notify_all();
+
+    runItems(0);
+
+    unique_lock<mutex> lock(m);
+    doneCv.wait(lock, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void threadPool::workerLoop (unsigned id) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> lock(m);
+            startCv.wait(lock, [&] { return stop || generation != seen; });
+            if (stop) return;
+            seen = generation;
+        }
+
+        runItems(id);
+
+        lock_guard<mutex> lock(m);
+        if (--busy == 0) doneCv.notify_one();
+    }
+}
+
+void threadPool::runItems (unsigned id) {
+    workRange &own = *ranges[id];
+    while (true) {
+        unsigned i = 0;
+        bool found;
+        {
+            lock_guard<mutex> lock(own.m);
+            found = own.begin < own.end;
+            if (found) i = own.begin++;
+        }
+
+        if (found) (*job)(i, id);
+        else if (!steal(id)) return;
+    }
+}
+
+// Moves the back half of the range of the next worker that still has items into the (empty) range of worker id.
+bool threadPool::steal (unsigned id) {
+    unsigned numThreads = size();
+    for (unsigned k = 1; k < numThreads; k++) {
+        workRange &victim = *ranges[(id + k) % numThreads];
+        unsigned begin, end;
+        {
+            lock_guard<mutex> lock(victim.m);
+            unsigned left = victim.end - victim.begin;
+            if (left == 0) continue;
+            end = victim.end;
+            begin = victim.end - (left + 1) / 2;
+            victim.end = begin;
+        }
+
+        workRange &own = *ranges[id];
+        lock_guard<mutex> lock(own.m);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+    return false;
+}
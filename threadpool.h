@@ -0,0 +1,57 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Small work-stealing thread pool for loops over independent items (e.g. one PODEM run per target fault). Every worker
+ owns a contiguous range of loop indices and takes items from its front. A worker that runs out of items steals the
+ back half of the range of another worker, so a few very hard items do not leave the other cores idle. The calling
+ thread takes part as worker 0.
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class threadPool {
+public:
+    explicit threadPool (unsigned numThreads);
+    ~threadPool();
+
+    // Calls task(i, worker) for every i in [0, n) and returns once all of them are done. worker is in [0, size()) and
+    // identifies the calling thread, so tasks can use per-worker scratch state without locking.
+    void parallelFor (unsigned n, const function<void(unsigned, unsigned)> &task);
+
+    unsigned size() const { return workers.size() + 1; }
+
+private:
+    struct workRange {
+        mutex m;
+        unsigned begin = 0, end = 0;
+    };
+
+    void workerLoop (unsigned id);
+    void runItems (unsigned id);
+    bool steal (unsigned id);
+
+    vector<thread> workers;
+    vector<unique_ptr<workRange>> ranges;
+    const function<void(unsigned, unsigned)>* job = nullptr;
+
+    mutex m;
+    condition_variable startCv, doneCv;
+    unsigned generation = 0; // Incremented for every parallelFor call so sleeping workers know there is new work.
+    unsigned busy = 0; // Helper threads that have not finished the current call.
+    bool stop = false;
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Collection and reporting of the ATPG counters (see trace.h).
+*/
+
+#include <algorithm>
+#include <fstream>
+#include "trace.h"
+
+traceLog podemTrace;
+
+void traceLog::clear() {
+    lock_guard<mutex> guard(lock);
+    faults.clear();
+    epoch = chrono::steady_clock::now();
+}
+
+double traceLog::now() const {
+    return chrono::duration<double, micro>(chrono::steady_clock::now() - epoch).count();
+}
+
+void traceLog::record (const faultCounters &fc) {
+    lock_guard<mutex> guard(lock);
+    faults.push_back(fc);
+}
+
+// Prints a histogram with power of two buckets: 0, 1, 2-3, 4-7, ..
+static void histogram (ostream &out, const char* name, const vector<uint64_t> &values) {
+    vector<unsigned> bucket;
+    for (auto v: values) {
+        unsigned b = v ? 64 - __builtin_clzll(v) : 0;
+        if (b >= bucket.size()) bucket.resize(b + 1, 0);
+        bucket[b]++;
+    }
+    out << name << ":" << endl;
+    for (unsigned b = 0; b < bucket.size(); b++) {
+        if (!bucket[b]) continue;
+        uint64_t lo = b ? 1ULL << (b - 1) : 0, hi = b ? (1ULL << b) - 1 : 0;
+        out << "  " << lo;
+        if (hi > lo) out << "-" << hi;
+        out << ": " << bucket[b] << endl;
+    }
+}
+
+void traceLog::writeSummary (ostream &out) const {
+    lock_guard<mutex> guard(lock);
+    faultCounters total;
+    vector<uint64_t> backtracks, evals, micros;
+    for (auto &fc: faults) {
+        total.decisions += fc.decisions;
+        total.backtracks += fc.backtracks;
+        total.implications += fc.implications;
+        total.gateEvals += fc.gateEvals;
+        total.xPathConflicts += fc.xPathConflicts;
+        total.micros += fc.micros;
+        backtracks.push_back(fc.backtracks);
+        evals.push_back(fc.gateEvals);
+        micros.push_back((uint64_t) fc.micros);
+    }
+
+    out << "PODEM TRACE OF " << faults.size() << " FAULTS: " << total.decisions << " decisions, " << total.backtracks;
+    out << " backtracks, " << total.implications << " implications, " << total.gateEvals << " gate evaluations, ";
+    out << total.xPathConflicts << " X-path conflicts, " << total.micros / 1e6 << " seconds." << endl;
+    histogram(out, "Backtracks per fault", backtracks);
+    histogram(out, "Gate evaluations per fault", evals);
+    histogram(out, "Microseconds per fault", micros);
+
+    vector<const faultCounters*> slow;
+    for (auto &fc: faults) slow.push_back(&fc);
+    unsigned n = min<size_t>(10, slow.size());
+    partial_sort(slow.begin(), slow.begin() + n, slow.end(),
+                 [](const faultCounters* a, const faultCounters* b) { return a->micros > b->micros; });
+    out << "Slowest faults:" << endl;
+    for (unsigned i = 0; i < n; i++) {
+        out << "  " << slow[i]->wire << " s-a-" << slow[i]->sa << ": " << slow[i]->micros << " us, ";
+        out << slow[i]->backtracks << " backtracks, " << slow[i]->gateEvals << " gate evaluations" << endl;
+    }
+}
+
+bool traceLog::writeChromeTrace (const string &path) const {
+    static const char* statusName[3] = {"detected", "redundant", "aborted"};
+    lock_guard<mutex> guard(lock);
+    ofstream out(path);
+    if (!out.is_open()) return false;
+
+    // Complete ("X") events, one per fault on the row of the worker thread that ran it.
+    out << "{\"traceEvents\": [";
+    for (unsigned i = 0; i < faults.size(); i++) {
+        const faultCounters &fc = faults[i];
+        out << (i ? ",\n" : "\n") << "{\"name\": \"" << fc.wire << " s-a-" << fc.sa << "\", \"cat\": \"podem\", \"ph\": \"X\"";
+        out << ", \"ts\": " << fc.start << ", \"dur\": " << fc.micros << ", \"pid\": 1, \"tid\": " << fc.worker;
+        out << ", \"args\": {\"status\": \"" << statusName[fc.status % 3] << "\", \"decisions\": " << fc.decisions;
+        out << ", \"backtracks\": " << fc.backtracks << ", \"implications\": " << fc.implications;
+        out << ", \"gateEvals\": " << fc.gateEvals << ", \"xPathConflicts\": " << fc.xPathConflicts << "}}";
+    }
+    out << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    return out.good();
+}
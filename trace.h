@@ -0,0 +1,68 @@
+/*
+ Author: Chibudem [Christian] Offodile
+ Date last modified: 10/16/2026
+ Class: ECE 6140-A
+
+ Description:
+ Instrumentation of the ATPG search. PODEM counts its decisions, backtracks, implications, gate evaluations and
+ X-path conflicts and times every fault; the per-fault counters are collected in a traceLog, which can print run-wide
+ totals and log2 histograms and write a Chrome trace (chrome://tracing or Perfetto) with one timeline slice per fault
+ and per worker thread, to find the faults that take the time.
+ The counting is only compiled in when PODEM_TRACE is defined. Otherwise the TRACE macros expand to nothing and the
+ search pays nothing for it.
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#ifdef PODEM_TRACE
+#define TRACE(stmt) stmt
+#else
+#define TRACE(stmt)
+#endif
+
+// Counters of one PODEM run.
+struct faultCounters {
+    unsigned wire = 0;
+    bool sa = false;
+    int status = 0; // eFaultStatus.
+    unsigned worker = 0;
+    uint64_t decisions = 0;
+    uint64_t backtracks = 0;
+    uint64_t implications = 0;
+    uint64_t gateEvals = 0;
+    uint64_t xPathConflicts = 0; // Backtracks because no D-Frontier gate (or not the fault site) had an X-path.
+    double start = 0.0; // Microseconds since the traceLog was cleared.
+    double micros = 0.0;
+};
+
+class traceLog {
+public:
+    traceLog() { clear(); }
+    void clear();
+
+    // Microseconds since the log was cleared, the clock of the counters.
+    double now() const;
+    void record (const faultCounters &fc); // Thread safe.
+
+    void writeSummary (ostream &out) const;
+    bool writeChromeTrace (const string &path) const;
+
+private:
+    chrono::steady_clock::time_point epoch;
+    mutable mutex lock;
+    vector<faultCounters> faults;
+};
+
+extern traceLog podemTrace; // Filled by runPODEM when PODEM_TRACE is defined.
+
+#endif